@@ -1,9 +1,17 @@
 #pragma once
 
+#include <span>
+#include <array>
+#include <tuple>
 #include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <algorithm>
 #include <functional>
+#include <string_view>
+#include <unordered_map>
 
 #include "from_chars.hpp"
 
@@ -12,37 +20,113 @@ namespace oryx::crt {
 namespace details {
 template <typename>
 constexpr bool always_false = false;
+
+template <class T>
+auto ParseArgValue(std::string_view value) -> std::optional<T> {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return std::string(value);
+    } else if constexpr (std::is_same_v<T, std::string_view>) {
+        return value;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return FromChars<T>(value);
+    } else if constexpr (std::is_integral_v<T>) {
+        return FromCharsPrefixed<T>(value);
+    } else if constexpr (std::is_floating_point_v<T> || detail::is_duration_v<T> || std::is_same_v<T, ByteSize>) {
+        return FromChars<T>(value);
+    } else {
+        static_assert(always_false<T>,
+                      "Get argument only supports std::string, std::string_view, bool, integral, floating point, "
+                      "std::chrono::duration and ByteSize types");
+    }
 }
 
+constexpr auto IsOptionToken(std::string_view token) -> bool {
+    // "-" usually names stdin and "-5" or "-.5" are negative numbers, all of them are values
+    return token.size() >= 2 && token[0] == '-' && !(token[1] >= '0' && token[1] <= '9') && token[1] != '.';
+}
+
+// Backing storage for the names of grouped short flags, "-abc" is indexed as "-a", "-b" and "-c"
+inline constexpr auto kShortOptionNames = [] {
+    std::array<char, 256 * 2> names{};
+    for (size_t i = 0; i < 256; ++i) {
+        names[i * 2] = '-';
+        names[i * 2 + 1] = static_cast<char>(i);
+    }
+    return names;
+}();
+
+constexpr auto ShortOptionName(char c) -> std::string_view {
+    return {kShortOptionNames.data() + static_cast<uint8_t>(c) * 2, 2};
+}
+}  // namespace details
+
+struct ArgumentParserConfig {
+    // Options that never take a value, "--verbose input.txt" then keeps input.txt positional
+    std::span<const std::string_view> flags{};
+    // Split "-abc" into the flags "-a", "-b" and "-c", otherwise "-abc" is a single option like "-threads 4"
+    bool group_short_flags{false};
+};
+
+/**
+ * @brief Command line parser, argv is tokenized once and options are looked up through a hash index
+ *
+ * Recognized forms are "--name value", "--name=value" and "-name value", with group_short_flags also "-abc". The token
+ * following an option is its value candidate unless it looks like an option or the option is a declared flag. Values
+ * are bound at lookup, GetValue<bool> only takes the candidate if it reads as a bool and is true otherwise, so
+ * "--verbose input.txt" is true, while GetValue<std::string> returns "input.txt". Candidates are not positional,
+ * declare flags in ArgumentParserConfig (ArgumentSchema does so for its bool options) to keep them positional.
+ * Everything after "--" is positional. Options may repeat, GetValue returns the first occurrence and GetValues all of
+ * them. Contains matches option names as well as any argv token. The parser keeps views into argv, which must
+ * outlive it.
+ *
+ * Every token is parsed, including argv[0]. Pass argc - 1 and argv + 1 from main() or the program name becomes the
+ * first positional.
+ */
 class ArgumentParser {
 public:
-    ArgumentParser(int argc, const char* const* argv)
-        : view_(argv, argc) {}
+    ArgumentParser(int argc, const char* const* argv, ArgumentParserConfig config = {})
+        : view_(argv, argc) {
+        Tokenize(config);
+    }
 
-    auto Contains(std::string_view option) const { return std::ranges::find(view_, option) != view_.end(); }
+    [[nodiscard]] auto Contains(std::string_view option) const -> bool { return index_.contains(option); }
 
+    /**
+     * @brief Value of the first occurrence of option, a bool option without value reads as true
+     */
     template <class T>
-    [[nodiscard]] constexpr auto GetValue(std::string_view option) const -> std::optional<T> {
-        auto it = std::ranges::find(view_, option);
-        if (it == view_.end()) {
+    [[nodiscard]] auto GetValue(std::string_view option) const -> std::optional<T> {
+        auto it = index_.find(option);
+        if (it == index_.end() || it->second.count == 0) {
             return std::nullopt;
         }
+        return ParseEntry<T>(entries_[it->second.first]);
+    }
 
-        auto vit = it + 1;
-        if (vit == view_.end()) {
-            return std::nullopt;
+    /**
+     * @brief Values of all occurrences of option in argv order, nullopt if any of them does not parse
+     */
+    template <class T>
+    [[nodiscard]] auto GetValues(std::string_view option) const -> std::optional<std::vector<T>> {
+        std::vector<T> values;
+        auto it = index_.find(option);
+        if (it == index_.end()) {
+            return values;
         }
 
-        if constexpr (std::is_same_v<T, std::string>) {
-            return std::string(*vit);
-        } else if constexpr (std::is_integral_v<T>) {
-            return FromChars<T>(*vit);
-        } else if constexpr (std::is_floating_point_v<T>) {
-            return FromChars<T>(*vit);
-        } else {
-            static_assert(details::always_false<T>,
-                          "Get argument only supports std::string integral and floating point types");
+        for (auto i = it->second.first; i != kNoEntry; i = entries_[i].next) {
+            auto value = ParseEntry<T>(entries_[i]);
+            if (!value) {
+                return std::nullopt;
+            }
+            values.push_back(std::move(*value));
         }
+        return values;
+    }
+
+    [[nodiscard]] auto Count(std::string_view option) const -> size_t {
+        auto it = index_.find(option);
+        return it == index_.end() ? 0 : it->second.count;
     }
 
     template <class T>
@@ -53,11 +137,220 @@ public:
         }
     }
 
+    [[nodiscard]] auto Positionals() const -> std::span<const std::string_view> { return positionals_; }
+
     auto Empty() const { return view_.empty(); }
     auto Size() const { return view_.size(); }
 
 private:
+    static constexpr uint32_t kNoEntry = UINT32_MAX;
+
+    struct Entry {
+        std::string_view name;
+        std::optional<std::string_view> value;
+        // "--name=value", the value is bound even if it does not parse
+        bool attached{};
+        uint32_t next{kNoEntry};
+    };
+
+    // Tokens that are not option names have an empty slot, they only answer Contains
+    struct Slot {
+        uint32_t first{kNoEntry};
+        uint32_t last{kNoEntry};
+        uint32_t count{};
+    };
+
+    template <class T>
+    static auto ParseEntry(const Entry& entry) -> std::optional<T> {
+        if constexpr (std::is_same_v<T, bool>) {
+            if (!entry.value) {
+                return true;
+            }
+            auto value = details::ParseArgValue<bool>(*entry.value);
+            return value || entry.attached ? value : true;
+        } else {
+            if (!entry.value) {
+                return std::nullopt;
+            }
+            return details::ParseArgValue<T>(*entry.value);
+        }
+    }
+
+    void Tokenize(const ArgumentParserConfig& config) {
+        entries_.reserve(view_.size());
+        index_.reserve(view_.size());
+
+        for (size_t i = 0; i < view_.size(); ++i) {
+            std::string_view token = view_[i];
+            index_.try_emplace(token);
+            if (token == "--") {
+                for (++i; i < view_.size(); ++i) {
+                    positionals_.push_back(view_[i]);
+                    index_.try_emplace(view_[i]);
+                }
+                break;
+            }
+            if (!details::IsOptionToken(token)) {
+                positionals_.push_back(token);
+                continue;
+            }
+
+            if (config.group_short_flags && token[1] != '-' && token.size() > 2) {
+                for (char c : token.substr(1)) {
+                    AddEntry(details::ShortOptionName(c), std::nullopt, false);
+                }
+                continue;
+            }
+
+            if (auto eq = token.find('='); token[1] == '-' && eq != std::string_view::npos) {
+                AddEntry(token.substr(0, eq), token.substr(eq + 1), true);
+                continue;
+            }
+
+            std::optional<std::string_view> value;
+            if (i + 1 < view_.size() && std::ranges::find(config.flags, token) == config.flags.end()) {
+                std::string_view next = view_[i + 1];
+                if (!details::IsOptionToken(next) && next != "--") {
+                    value = next;
+                    index_.try_emplace(next);
+                    ++i;
+                }
+            }
+            AddEntry(token, value, false);
+        }
+    }
+
+    void AddEntry(std::string_view name, std::optional<std::string_view> value, bool attached) {
+        auto pos = static_cast<uint32_t>(entries_.size());
+        entries_.push_back({name, value, attached});
+
+        auto& slot = index_[name];
+        if (slot.count == 0) {
+            slot.first = pos;
+        } else {
+            entries_[slot.last].next = pos;
+        }
+        slot.last = pos;
+        ++slot.count;
+    }
+
     std::basic_string_view<const char*> view_;
+    std::vector<Entry> entries_;
+    std::vector<std::string_view> positionals_;
+    std::unordered_map<std::string_view, Slot> index_;
+};
+
+/**
+ * @brief Option name usable as template argument, e.g. Option<"--port", int>
+ */
+template <size_t N>
+struct OptionName {
+    consteval OptionName(const char (&name)[N]) { std::copy_n(name, N, value); }
+
+    [[nodiscard]] constexpr auto View() const -> std::string_view { return {value, N - 1}; }
+
+    char value[N]{};
+};
+
+/**
+ * @brief Typed option of an ArgumentSchema with the value used when it is absent from argv
+ */
+template <OptionName Name, class T>
+struct Option {
+    using value_type = T;
+    static constexpr std::string_view kName = Name.View();
+
+    T default_value{};
+};
+
+/**
+ * @brief Values of an ArgumentSchema resolved against an ArgumentParser
+ */
+template <class... Options>
+class ParsedArguments {
+public:
+    explicit ParsedArguments(std::tuple<typename Options::value_type...> values)
+        : values_(std::move(values)) {}
+
+    template <OptionName Name>
+    [[nodiscard]] auto Get() const -> const auto& {
+        constexpr auto index = IndexOf(Name.View());
+        static_assert(index < sizeof...(Options), "Option is not part of the schema");
+        return std::get<index>(values_);
+    }
+
+    static constexpr auto IndexOf(std::string_view name) -> size_t {
+        constexpr std::array<std::string_view, sizeof...(Options)> names{Options::kName...};
+        return static_cast<size_t>(std::ranges::find(names, name) - names.begin());
+    }
+
+private:
+    std::tuple<typename Options::value_type...> values_;
+};
+
+/**
+ * @brief Compile time description of the options a program accepts
+ *
+ * Looking up an option that is not part of the schema fails to compile and values have the declared type. bool options
+ * are flags and never take the following token.
+ *
+ *     constexpr ArgumentSchema schema{Option<"--port", int>{8080}, Option<"--verbose", bool>{}};
+ *     auto args = schema.Parse(argc - 1, argv + 1);
+ *     int port = args->Get<"--port">();
+ */
+template <class... Options>
+class ArgumentSchema {
+public:
+    // Names of the bool options, pass them as ArgumentParserConfig::flags when building the parser yourself
+    static constexpr auto kFlags = [] {
+        std::array<std::string_view, (size_t{std::is_same_v<typename Options::value_type, bool>} + ... + 0)> flags{};
+        size_t i{};
+        ((std::is_same_v<typename Options::value_type, bool> ? void(flags[i++] = Options::kName) : void()), ...);
+        return flags;
+    }();
+
+    constexpr explicit ArgumentSchema(Options... options)
+        : options_(std::move(options)...) {}
+
+    /**
+     * @brief Tokenize argv with the schema flags and resolve every option
+     */
+    [[nodiscard]] auto Parse(int argc, const char* const* argv) const -> std::optional<ParsedArguments<Options...>> {
+        return Parse(ArgumentParser(argc, argv, {.flags = kFlags}));
+    }
+
+    /**
+     * @brief Resolve every option, absent ones take their default
+     *
+     * @return nullopt if an option is present but its value does not parse
+     */
+    [[nodiscard]] auto Parse(const ArgumentParser& parser) const -> std::optional<ParsedArguments<Options...>> {
+        bool valid = true;
+        auto resolve = [&]<class Opt>(const Opt& option) -> typename Opt::value_type {
+            if (parser.Count(Opt::kName) == 0) {
+                return option.default_value;
+            }
+            auto value = parser.GetValue<typename Opt::value_type>(Opt::kName);
+            if (!value) {
+                valid = false;
+                return option.default_value;
+            }
+            return std::move(*value);
+        };
+
+        auto values = std::apply(
+                [&](const auto&... option) {
+                    return std::tuple<typename Options::value_type...>{resolve(option)...};
+                },
+                options_);
+        if (!valid) {
+            return std::nullopt;
+        }
+        return ParsedArguments<Options...>(std::move(values));
+    }
+
+private:
+    std::tuple<Options...> options_;
 };
 
-}  // namespace oryx::crt
\ No newline at end of file
+}  // namespace oryx::crt
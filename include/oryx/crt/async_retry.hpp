@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "retry.hpp"
+#include "thread_pool.hpp"
+
+namespace oryx::crt::retry {
+namespace detail {
+
+/**
+ * @brief Non blocking counterpart of retry::ExponentialBackoff.
+ *
+ * Attempts run on the given thread pool, the waits in between are timers managed by a single internal thread. No
+ * thread is blocked while a retry loop is backing off, so a single instance can drive thousands of loops.
+ *
+ * Retry loops still waiting for their next attempt when the retrier is destroyed are abandoned, their futures report
+ * std::future_errc::broken_promise.
+ */
+template <class Clock>
+    requires std::chrono::is_clock_v<Clock>
+class AsyncRetrierImpl : public std::enable_shared_from_this<AsyncRetrierImpl<Clock>> {
+public:
+    using Duration = ExponentialConfig::Duration;
+    using TimePoint = Clock::time_point;
+    using ThreadPool = BS::thread_pool<BS::tp::none>;
+
+    /**
+     * @brief Start a retry loop, on_done(result, error) is invoked on a pool thread with the final result
+     *
+     * error holds the exception thrown by retryable, result is value initialized in that case. on_done must not throw,
+     * the pool discards exceptions escaping its tasks.
+     */
+    template <std::invocable F, class Callback>
+        requires std::invocable<Callback, std::invoke_result_t<F>, std::exception_ptr>
+    void ExponentialBackoff(ExponentialConfig config, F &&retryable, Callback &&on_done) {
+        Start(config, std::forward<F>(retryable), std::forward<Callback>(on_done));
+    }
+
+    /**
+     * @brief Start a retry loop, the returned future holds the final result or the exception thrown by retryable
+     */
+    template <std::invocable F>
+    auto ExponentialBackoff(ExponentialConfig config, F &&retryable) -> std::future<std::invoke_result_t<F>> {
+        using Result = std::invoke_result_t<F>;
+
+        auto promise = std::make_shared<std::promise<Result>>();
+        auto future = promise->get_future();
+        auto sink = [promise](Result result, std::exception_ptr error) {
+            if (error) {
+                promise->set_exception(std::move(error));
+            } else {
+                promise->set_value(std::move(result));
+            }
+        };
+        Start(config, std::forward<F>(retryable), std::move(sink));
+        return future;
+    }
+
+    auto GetNumPending() const -> size_t {
+        std::lock_guard lock{mtx_};
+        return timers_.size();
+    }
+
+    static auto Create(ThreadPool &pool) -> std::shared_ptr<AsyncRetrierImpl> {
+        return std::shared_ptr<AsyncRetrierImpl>(new AsyncRetrierImpl(pool));
+    }
+
+private:
+    template <class F, class Sink>
+    struct RetryLoop {
+        ExponentialConfig config;
+        F retryable;
+        Sink sink;
+        Backoff backoff;
+        uint64_t num_retries;
+    };
+
+    struct Timer {
+        TimePoint deadline;
+        uint64_t sequence;
+        std::function<void()> fire;
+    };
+
+    // Inverted so the heap functions keep the earliest deadline at the front
+    struct FiresLater {
+        auto operator()(const Timer &lhs, const Timer &rhs) const -> bool {
+            return std::tie(lhs.deadline, lhs.sequence) > std::tie(rhs.deadline, rhs.sequence);
+        }
+    };
+
+    AsyncRetrierImpl(ThreadPool &pool)
+        : pool_(pool),
+          timers_(),
+          mtx_(),
+          cv_(),
+          timer_counter_(),
+          worker_([this](const std::stop_token &stoken) { TimerLoop(stoken); }) {}
+
+    template <class F, class Sink>
+    void Start(ExponentialConfig config, F &&retryable, Sink &&sink) {
+        using Loop = RetryLoop<std::decay_t<F>, std::decay_t<Sink>>;
+        using Result = std::invoke_result_t<F>;
+
+        auto loop = std::make_shared<Loop>(config, std::forward<F>(retryable), std::forward<Sink>(sink),
+                                           Backoff{config}, 0);
+        if (config.budget) {
+            config.budget->Deposit();
+        }
+        if (config.max_retries == 0) {
+            pool_.detach_task([loop = std::move(loop)]() { std::invoke(loop->sink, Result{}, nullptr); });
+            return;
+        }
+        Attempt(std::move(loop));
+    }
+
+    template <class Loop>
+    void Attempt(std::shared_ptr<Loop> loop) {
+        pool_.detach_task([weak = this->weak_from_this(), loop = std::move(loop)]() mutable {
+            using Result = decltype(std::invoke(loop->retryable));
+
+            Result result;
+            try {
+                result = std::invoke(loop->retryable);
+            } catch (...) {
+                std::invoke(loop->sink, Result{}, std::current_exception());
+                return;
+            }
+
+            if (result || ++loop->num_retries >= loop->config.max_retries) {
+                std::invoke(loop->sink, std::move(result), nullptr);
+                return;
+            }
+
+            if (loop->config.budget && !loop->config.budget->TryWithdraw()) {
+                std::invoke(loop->sink, std::move(result), nullptr);
+                return;
+            }
+
+            auto self = weak.lock();
+            if (!self) {
+                return;
+            }
+
+            auto deadline = Clock::now() + loop->backoff.Next();
+            self->Arm(deadline,
+                      [self = self.get(), loop = std::move(loop)]() mutable { self->Attempt(std::move(loop)); });
+        });
+    }
+
+    void Arm(TimePoint deadline, std::function<void()> &&fire) {
+        std::unique_lock lock{mtx_};
+        timers_.push_back(Timer{deadline, timer_counter_++, std::move(fire)});
+        std::ranges::push_heap(timers_, FiresLater{});
+        lock.unlock();
+        cv_.notify_all();
+    }
+
+    void TimerLoop(const std::stop_token &stoken) {
+        std::stop_callback scb{stoken, [this]() { cv_.notify_all(); }};
+
+        while (!stoken.stop_requested()) {
+            std::unique_lock lock{mtx_};
+            if (timers_.empty()) {
+                cv_.wait(lock, stoken, [this] { return !timers_.empty(); });
+                continue;
+            }
+
+            auto deadline = timers_.front().deadline;
+            if (Clock::now() < deadline) {
+                cv_.wait_until(lock, stoken, deadline,
+                               [this, deadline]() { return timers_.front().deadline < deadline; });
+                continue;
+            }
+
+            std::ranges::pop_heap(timers_, FiresLater{});
+            auto timer = std::move(timers_.back());
+            timers_.pop_back();
+            lock.unlock();
+
+            timer.fire();
+        }
+    }
+
+    ThreadPool &pool_;
+    std::vector<Timer> timers_;
+    mutable std::mutex mtx_;
+    std::condition_variable_any cv_;
+    uint64_t timer_counter_;
+    std::jthread worker_;
+};
+
+}  // namespace detail
+
+using AsyncRetrier = detail::AsyncRetrierImpl<std::chrono::steady_clock>;
+using AsyncRetrierPtr = std::shared_ptr<AsyncRetrier>;
+
+}  // namespace oryx::crt::retry
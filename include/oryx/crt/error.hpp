@@ -2,21 +2,99 @@
 
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <utility>
+#include <cstddef>
 
 namespace oryx::crt {
 
+/**
+ * @brief Message with static storage duration, only constructible from string literals at compile time
+ */
+class StaticMessage {
+public:
+    template <size_t N>
+    consteval StaticMessage(const char (&what)[N])
+        : what_(what, N - 1) {}
+
+    [[nodiscard]] constexpr auto View() const noexcept -> std::string_view { return what_; }
+
+private:
+    std::string_view what_;
+};
+
 /**
  * @brief Base error class for exception free programming
+ *
+ * Errors created through Literal() only keep a view to the static message and never allocate. Dynamic messages are
+ * owned, short ones fit into the small string buffer of std::string.
  */
 class Error {
 public:
-    explicit Error(std::string what)
-        : what_(std::move(what)) {}
+    explicit Error(std::string what, std::error_code code = {})
+        : owned_(std::move(what)),
+          what_(owned_),
+          code_(code) {}
+
+    explicit Error(std::error_code code)
+        : Error(code.message(), code) {}
 
-    [[nodiscard]] auto what() const -> std::string_view { return what_; }
+    [[nodiscard]] static auto Literal(StaticMessage what, std::error_code code = {}) noexcept -> Error {
+        return Error(LiteralTag{}, what.View(), code);
+    }
+
+    Error(const Error& other)
+        : owned_(other.owned_),
+          what_(other.IsOwned() ? std::string_view(owned_) : other.what_),
+          code_(other.code_) {}
+
+    Error(Error&& other) noexcept
+        : owned_(),
+          what_(),
+          code_() {
+        *this = std::move(other);
+    }
+
+    auto operator=(const Error& other) -> Error& {
+        if (this != &other) {
+            owned_ = other.owned_;
+            what_ = other.IsOwned() ? std::string_view(owned_) : other.what_;
+            code_ = other.code_;
+        }
+        return *this;
+    }
+
+    auto operator=(Error&& other) noexcept -> Error& {
+        if (this != &other) {
+            const bool is_owned = other.IsOwned();
+            owned_ = std::move(other.owned_);
+            what_ = is_owned ? std::string_view(owned_) : other.what_;
+            code_ = other.code_;
+            if (is_owned) {
+                other.what_ = other.owned_;
+            }
+        }
+        return *this;
+    }
+
+    ~Error() = default;
+
+    [[nodiscard]] auto what() const noexcept -> std::string_view { return what_; }
+    [[nodiscard]] auto code() const noexcept -> std::error_code { return code_; }
 
 private:
-    std::string what_;
+    struct LiteralTag {};
+
+    Error(LiteralTag, std::string_view what, std::error_code code) noexcept
+        : owned_(),
+          what_(what),
+          code_(code) {}
+
+    auto IsOwned() const noexcept -> bool { return what_.data() == owned_.data(); }
+
+    std::string owned_;
+    std::string_view what_;
+    std::error_code code_;
 };
 
 }  // namespace oryx::crt
\ No newline at end of file
@@ -1,14 +1,21 @@
 #pragma once
 
-#include <vector>
+#include <span>
+#include <string>
 #include <format>
+#include <string_view>
+#include <iterator>
 
 #include "error.hpp"
+#include "small_vector.hpp"
 
 namespace oryx::crt {
 
 class ErrorGroup {
 public:
+    // Groups up to this many errors do not allocate
+    static constexpr size_t kInlineErrors = 4;
+
     ErrorGroup() = default;
 
     ErrorGroup(std::initializer_list<Error> errors)
@@ -20,20 +27,65 @@ public:
 
     [[nodiscard]] auto Empty() const noexcept -> bool { return errors_.empty(); }
 
-    [[nodiscard]] auto Errors() const -> const std::vector<Error>& { return errors_; }
+    [[nodiscard]] auto Errors() const noexcept -> std::span<const Error> { return errors_; }
 
     [[nodiscard]] auto ToError() const -> Error { return Error(what()); }
 
     [[nodiscard]] auto what() const -> std::string {
-        auto what = std::format("ErrorGroup with {} error(s):\n", errors_.size());
+        std::string what;
+        what.reserve(FormattedSize());
+        FormatTo(std::back_inserter(what));
+        return what;
+    }
+
+    /**
+     * @brief Write the message returned by what() to out without building an intermediate string
+     */
+    template <std::output_iterator<const char&> OutputIt>
+    auto FormatTo(OutputIt out) const -> OutputIt {
+        out = std::format_to(out, kHeaderFormat, errors_.size());
         for (size_t i = 0; i < errors_.size(); ++i) {
-            what.append(std::format("[{}] {}", i, errors_[i].what()));
+            out = std::format_to(out, kEntryFormat, i, errors_[i].what());
         }
-        return what;
+        return out;
+    }
+
+    [[nodiscard]] auto FormattedSize() const noexcept -> size_t {
+        // Each "{}" is replaced by a number or an error message
+        constexpr size_t kPlaceholder = std::string_view("{}").size();
+
+        size_t size = kHeaderFormat.size() - kPlaceholder + CountDigits(errors_.size());
+        for (size_t i = 0; i < errors_.size(); ++i) {
+            size += kEntryFormat.size() - 2 * kPlaceholder + CountDigits(i) + errors_[i].what().size();
+        }
+        return size;
     }
 
 private:
-    std::vector<Error> errors_;
+    // Shared by FormatTo() and FormattedSize()
+    static constexpr std::string_view kHeaderFormat = "ErrorGroup with {} error(s):\n";
+    static constexpr std::string_view kEntryFormat = "[{}] {}";
+
+    static constexpr auto CountDigits(size_t value) noexcept -> size_t {
+        size_t digits = 1;
+        while (value >= 10) {
+            value /= 10;
+            ++digits;
+        }
+        return digits;
+    }
+
+    SmallVector<Error, kInlineErrors> errors_;
 };
 
-}  // namespace oryx::crt
\ No newline at end of file
+}  // namespace oryx::crt
+
+template <>
+struct std::formatter<oryx::crt::ErrorGroup> {
+    constexpr auto parse(std::format_parse_context& ctx) { return ctx.begin(); }
+
+    template <class FormatContext>
+    auto format(const oryx::crt::ErrorGroup& group, FormatContext& ctx) const {
+        return group.FormatTo(ctx.out());
+    }
+};
\ No newline at end of file
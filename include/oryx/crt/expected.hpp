@@ -26,6 +26,8 @@ inline constexpr void_expected<Error> kVoidExpected{};
 [[nodiscard]] inline auto UnexpectedError(const char* what) { return unexpected<Error>(what); }
 [[nodiscard]] inline auto UnexpectedError(const std::string& what) { return unexpected<Error>(what); }
 [[nodiscard]] inline auto UnexpectedError(const std::exception& exc) { return unexpected<Error>(exc.what()); }
+[[nodiscard]] inline auto UnexpectedError(std::error_code code) { return unexpected<Error>(code); }
+[[nodiscard]] inline auto UnexpectedError(Error&& error) { return unexpected<Error>(std::move(error)); }
 
 #endif
 
@@ -1,33 +1,211 @@
 #pragma once
 
+#include <bit>
+#include <algorithm>
+#include <span>
+#include <ratio>
+#include <chrono>
+#include <compare>
+#include <limits>
 #include <string_view>
 #include <optional>
+#include <concepts>
 #include <cstdint>
+#include <cstring>
 #include <charconv>
+#include <type_traits>
 
 // std::optional wrapper around the from chars interface
 
 namespace oryx::crt {
 
+/**
+ * @brief Number of bytes, parsed from human readable sizes like "64MiB" or "10kb"
+ */
+struct ByteSize {
+    uint64_t bytes{};
+
+    constexpr auto operator<=>(const ByteSize&) const = default;
+};
+
+namespace detail {
+
+template <class T>
+struct is_duration : std::false_type {};
+
+template <class Rep, class Period>
+struct is_duration<std::chrono::duration<Rep, Period>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_duration_v = is_duration<T>::value;
+
+constexpr auto EqualsIgnoreCase(std::string_view lhs, std::string_view rhs) -> bool {
+    constexpr auto to_lower = [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; };
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        if (to_lower(lhs[i]) != to_lower(rhs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Parse the leading digits of s in the given base and remove them from s
+ *
+ * Returns nullopt if there are no digits or the value does not fit into 64 bits.
+ */
+constexpr auto ConsumeUnsigned(std::string_view& s, unsigned base = 10) -> std::optional<uint64_t> {
+    uint64_t value{};
+    size_t i{};
+    for (; i < s.size(); ++i) {
+        char c = s[i];
+        unsigned digit;
+        if (c >= '0' && c <= '9') {
+            digit = static_cast<unsigned>(c - '0');
+        } else if (c >= 'a' && c <= 'z') {
+            digit = static_cast<unsigned>(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'Z') {
+            digit = static_cast<unsigned>(c - 'A' + 10);
+        } else {
+            break;
+        }
+
+        if (digit >= base) {
+            break;
+        }
+        if (value > (std::numeric_limits<uint64_t>::max() - digit) / base) {
+            return std::nullopt;
+        }
+        value = value * base + digit;
+    }
+
+    if (i == 0) {
+        return std::nullopt;
+    }
+    s.remove_prefix(i);
+    return value;
+}
+
+// Convert count units of Period into Duration, fails if the result is not exact or does not fit
+template <class Duration, class Period>
+constexpr auto ScaleDuration(uint64_t count) -> std::optional<Duration> {
+    using Ratio = std::ratio_divide<Period, typename Duration::period>;
+    using Rep = typename Duration::rep;
+
+    if constexpr (std::is_floating_point_v<Rep>) {
+        return Duration(static_cast<Rep>(count) * Ratio::num / Ratio::den);
+    } else {
+        constexpr auto kMax = static_cast<uint64_t>(std::numeric_limits<Rep>::max());
+        if (count > kMax / Ratio::num) {
+            return std::nullopt;
+        }
+
+        auto scaled = count * Ratio::num;
+        if (scaled % Ratio::den != 0) {
+            return std::nullopt;
+        }
+        return Duration(static_cast<Rep>(scaled / Ratio::den));
+    }
+}
+
+template <class Duration>
+constexpr auto ParseDuration(std::string_view s) -> std::optional<Duration> {
+    auto count = ConsumeUnsigned(s);
+    if (!count) {
+        return std::nullopt;
+    }
+
+    if (s == "ns") return ScaleDuration<Duration, std::nano>(*count);
+    if (s == "us") return ScaleDuration<Duration, std::micro>(*count);
+    if (s == "ms") return ScaleDuration<Duration, std::milli>(*count);
+    if (s == "s") return ScaleDuration<Duration, std::ratio<1>>(*count);
+    if (s == "m" || s == "min") return ScaleDuration<Duration, std::ratio<60>>(*count);
+    if (s == "h") return ScaleDuration<Duration, std::ratio<3600>>(*count);
+    if (s == "d") return ScaleDuration<Duration, std::ratio<86400>>(*count);
+    return std::nullopt;
+}
+
+constexpr auto ParseByteSize(std::string_view s) -> std::optional<ByteSize> {
+    struct Unit {
+        std::string_view suffix;
+        uint64_t multiplier;
+    };
+    constexpr Unit kUnits[] = {
+        {"", 1},
+        {"b", 1},
+        {"kb", 1000},
+        {"kib", uint64_t{1} << 10},
+        {"mb", 1000 * 1000},
+        {"mib", uint64_t{1} << 20},
+        {"gb", 1000 * 1000 * 1000},
+        {"gib", uint64_t{1} << 30},
+        {"tb", uint64_t{1000} * 1000 * 1000 * 1000},
+        {"tib", uint64_t{1} << 40},
+    };
+
+    auto count = ConsumeUnsigned(s);
+    if (!count) {
+        return std::nullopt;
+    }
+
+    for (const auto& unit : kUnits) {
+        if (EqualsIgnoreCase(s, unit.suffix)) {
+            if (*count > std::numeric_limits<uint64_t>::max() / unit.multiplier) {
+                return std::nullopt;
+            }
+            return ByteSize{*count * unit.multiplier};
+        }
+    }
+    return std::nullopt;
+}
+
+}  // namespace detail
+
 /**
  * @brief std::from_chars wrapper, returning nullopt if from chars reports error
  *
+ * std::chrono::duration types are parsed from "<count><unit>" with unit one of ns, us, ms, s, m / min, h, d and fail if
+ * the value is not exactly representable. ByteSize accepts an optional case insensitive b, kb, kib, ... tb, tib suffix.
+ *
  * @tparam T
  * @param s
  * @return std::optional<T>
  */
 template <typename T>
 constexpr auto FromChars(std::string_view s) -> std::optional<T> {
-    T val;
-    if (std::from_chars(s.data(), s.data() + s.size(), val).ec == std::errc{}) {
-        return val;
+    if constexpr (detail::is_duration_v<T>) {
+        return detail::ParseDuration<T>(s);
+    } else if constexpr (std::is_same_v<T, ByteSize>) {
+        return detail::ParseByteSize(s);
     } else {
-        return std::nullopt;
+        T val;
+        if (std::from_chars(s.data(), s.data() + s.size(), val).ec == std::errc{}) {
+            return val;
+        } else {
+            return std::nullopt;
+        }
     }
 }
 
+/**
+ * @brief Accepts true / false, yes / no, on / off in any case and numbers, where everything but 0 is true
+ */
 template <>
 constexpr auto FromChars<bool>(std::string_view s) -> std::optional<bool> {
+    for (std::string_view word : {"true", "yes", "on"}) {
+        if (detail::EqualsIgnoreCase(s, word)) {
+            return true;
+        }
+    }
+    for (std::string_view word : {"false", "no", "off"}) {
+        if (detail::EqualsIgnoreCase(s, word)) {
+            return false;
+        }
+    }
+
 #if __cpp_lib_optional >= 202110L
     return FromChars<uint8_t>(s).transform([](uint8_t val) { return static_cast<bool>(val); });
 #else
@@ -39,4 +217,158 @@ constexpr auto FromChars<bool>(std::string_view s) -> std::optional<bool> {
 #endif
 }
 
+/**
+ * @brief Parse integers with an optional 0x, 0o or 0b base prefix, the whole input has to be consumed
+ */
+template <std::integral T>
+constexpr auto FromCharsPrefixed(std::string_view s) -> std::optional<T> {
+    bool negative = false;
+    if (!s.empty() && s.front() == '-') {
+        if constexpr (std::is_unsigned_v<T>) {
+            return std::nullopt;
+        }
+        negative = true;
+        s.remove_prefix(1);
+    }
+
+    unsigned base = 10;
+    if (s.size() > 2 && s[0] == '0') {
+        switch (s[1]) {
+            case 'x':
+            case 'X':
+                base = 16;
+                break;
+            case 'o':
+            case 'O':
+                base = 8;
+                break;
+            case 'b':
+            case 'B':
+                base = 2;
+                break;
+            default:
+                break;
+        }
+        if (base != 10) {
+            s.remove_prefix(2);
+        }
+    }
+
+    auto value = detail::ConsumeUnsigned(s, base);
+    if (!value || !s.empty()) {
+        return std::nullopt;
+    }
+
+    constexpr auto kMax = static_cast<uint64_t>(std::numeric_limits<T>::max());
+    if (negative) {
+        if (*value > kMax + 1) {
+            return std::nullopt;
+        }
+        return static_cast<T>(0 - static_cast<std::make_unsigned_t<T>>(*value));
+    }
+    if (*value > kMax) {
+        return std::nullopt;
+    }
+    return static_cast<T>(*value);
+}
+
+namespace detail {
+
+inline auto IsEightDigits(uint64_t chunk) noexcept -> bool {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+           0x3333333333333333;
+}
+
+// SWAR conversion of eight ascii digits loaded in little endian order
+inline auto ParseEightDigits(uint64_t chunk) noexcept -> uint64_t {
+    chunk = (chunk & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+    chunk = (chunk & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+    return (chunk & 0x0000FFFF0000FFFF) * 42949672960001 >> 32;
+}
+
+/**
+ * @brief Parse fields made up only of digits (and a leading '-' for signed types) that cannot overflow T
+ *
+ * Returns false if the fast path does not apply, the caller then falls back to std::from_chars.
+ */
+template <std::integral T>
+auto FromCharsDigits(std::string_view s, T& out) noexcept -> bool {
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        if (!s.empty() && s.front() == '-') {
+            negative = true;
+            s.remove_prefix(1);
+        }
+    }
+
+    if (s.empty() || s.size() > static_cast<size_t>(std::numeric_limits<T>::digits10)) {
+        return false;
+    }
+
+    uint64_t value{};
+    size_t i{};
+    if constexpr (std::endian::native == std::endian::little) {
+        for (; i + 8 <= s.size(); i += 8) {
+            uint64_t chunk;
+            std::memcpy(&chunk, s.data() + i, sizeof(chunk));
+            if (!IsEightDigits(chunk)) {
+                return false;
+            }
+            value = value * 100000000 + ParseEightDigits(chunk);
+        }
+    }
+
+    for (; i < s.size(); ++i) {
+        auto digit = static_cast<uint8_t>(s[i] - '0');
+        if (digit > 9) {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+
+    out = negative ? static_cast<T>(0 - static_cast<std::make_unsigned_t<T>>(value)) : static_cast<T>(value);
+    return true;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Parse a column of fields with the same rules as FromChars
+ *
+ * Field i is written to out[i] and bit i % 64 of valid[i / 64] is set if it parsed, failed fields are set to T{}.
+ * valid is a little-endian bitmap, field 0 is the lowest bit of valid[0], field 64 the lowest bit of valid[1]. Bits
+ * past the last parsed field are left untouched. Integer fields consisting only of digits are converted eight digits
+ * at a time, everything else goes through std::from_chars.
+ *
+ * Only the first min(fields.size(), out.size(), valid.size() * 64) fields are parsed, size out and valid for the whole
+ * column.
+ *
+ * @return Number of fields that parsed
+ */
+template <typename T>
+auto FromCharsBatch(std::span<const std::string_view> fields, std::span<T> out, std::span<uint64_t> valid) -> size_t {
+    const auto count = std::min({fields.size(), out.size(), valid.size() * 64});
+    size_t num_valid{};
+    for (size_t i = 0; i < count; ++i) {
+        bool parsed;
+        if constexpr (std::integral<T> && !std::same_as<T, bool>) {
+            parsed = detail::FromCharsDigits(fields[i], out[i]);
+            if (!parsed) {
+                auto value = FromChars<T>(fields[i]);
+                parsed = value.has_value();
+                out[i] = value.value_or(T{});
+            }
+        } else {
+            auto value = FromChars<T>(fields[i]);
+            parsed = value.has_value();
+            out[i] = value.value_or(T{});
+        }
+
+        auto bit = uint64_t{1} << (i % 64);
+        valid[i / 64] = parsed ? valid[i / 64] | bit : valid[i / 64] & ~bit;
+        num_valid += parsed;
+    }
+    return num_valid;
+}
+
 }  // namespace oryx::crt
\ No newline at end of file
@@ -131,6 +131,10 @@
         ((std::max)(8u, std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() - 1 : 0))
 #endif
 
+#ifndef CPPHTTPLIB_RING_THREAD_POOL_CAPACITY
+    #define CPPHTTPLIB_RING_THREAD_POOL_CAPACITY 1024
+#endif
+
 #ifndef CPPHTTPLIB_RECV_FLAGS
     #define CPPHTTPLIB_RECV_FLAGS 0
 #endif
@@ -143,6 +147,18 @@
     #define CPPHTTPLIB_LISTEN_BACKLOG 5
 #endif
 
+#ifndef CPPHTTPLIB_FILE_CACHE_MAX_ENTRIES
+    #define CPPHTTPLIB_FILE_CACHE_MAX_ENTRIES 1024
+#endif
+
+#ifndef CPPHTTPLIB_FILE_CACHE_REVALIDATE_MSEC
+    #define CPPHTTPLIB_FILE_CACHE_REVALIDATE_MSEC 1000
+#endif
+
+#ifndef CPPHTTPLIB_EVENT_LOOP_MAX_EVENTS
+    #define CPPHTTPLIB_EVENT_LOOP_MAX_EVENTS 256
+#endif
+
 #ifndef CPPHTTPLIB_MAX_LINE_LENGTH
     #define CPPHTTPLIB_MAX_LINE_LENGTH 32768
 #endif
@@ -223,6 +239,9 @@ using socklen_t = int;
     #include <netinet/in.h>
     #ifdef __linux__
         #include <resolv.h>
+        #include <sys/epoll.h>
+        #include <sys/eventfd.h>
+        #include <sys/sendfile.h>
     #endif
     #include <csignal>
     #include <netinet/tcp.h>
@@ -394,8 +413,186 @@ struct hash {
     }
 };
 
+// Eight bytes at a time, ASCII letters only. Header names are tokens, which
+// never contain the Latin-1 letters to_lower() folds as well.
+inline uint64_t load_word(const char *s, size_t l) {
+    uint64_t w = 0;
+    if (l >= sizeof(w)) {
+        memcpy(&w, s, sizeof(w));
+    } else {
+        for (size_t i = 0; i < l; i++) {
+            w |= static_cast<uint64_t>(static_cast<unsigned char>(s[i])) << (i * 8);
+        }
+    }
+    return w;
+}
+
+inline uint64_t fold_word(uint64_t w) {
+    const uint64_t ones = 0x0101010101010101ull;
+    const uint64_t ascii = w & (ones * 0x7F);
+    const uint64_t upper = (ascii + ones * (0x80 - 'A')) & ~(ascii + ones * (0x7F - 'Z')) & ~w & (ones * 0x80);
+    return w | (upper >> 2);
+}
+
+inline size_t fast_hash(const char *s, size_t l) {
+    uint64_t h = l;
+    for (size_t i = 0; i < l; i += 8) {
+        h = (h ^ fold_word(load_word(s + i, l - i))) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 29;
+    }
+    return static_cast<size_t>(h);
+}
+
+inline bool fast_equal(const std::string &a, const std::string &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i += 8) {
+        auto n = a.size() - i;
+        if (fold_word(load_word(a.data() + i, n)) != fold_word(load_word(b.data() + i, n))) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }  // namespace case_ignore
 
+/**
+ * Flat replacement for the Headers multimap, enabled by CPPHTTPLIB_FLAT_HEADERS.
+ * One vector holds all fields, so a typical request allocates it once plus the
+ * strings too long for SSO. Names hash once on insertion into a parallel
+ * vector and compare with case_ignore::fast_equal. Fields with equal names
+ * stay adjacent, which keeps equal_range working, and groups keep insertion
+ * order. Names must not be modified through iterators.
+ */
+class FlatHeaders {
+public:
+    using key_type = std::string;
+    using mapped_type = std::string;
+    using value_type = std::pair<std::string, std::string>;
+    using iterator = std::vector<value_type>::iterator;
+    using const_iterator = std::vector<value_type>::const_iterator;
+    using size_type = size_t;
+
+    FlatHeaders() = default;
+    FlatHeaders(std::initializer_list<value_type> init) { insert(init.begin(), init.end()); }
+    template <typename It>
+    FlatHeaders(It first, It last) {
+        insert(first, last);
+    }
+
+    iterator begin() { return entries_.begin(); }
+    iterator end() { return entries_.end(); }
+    const_iterator begin() const { return entries_.begin(); }
+    const_iterator end() const { return entries_.end(); }
+    const_iterator cbegin() const { return entries_.cbegin(); }
+    const_iterator cend() const { return entries_.cend(); }
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    void clear() {
+        entries_.clear();
+        hashes_.clear();
+    }
+    void reserve(size_t n) {
+        entries_.reserve(n);
+        hashes_.reserve(n);
+    }
+
+    template <typename K, typename V>
+    iterator emplace(K &&key, V &&value) {
+        if (entries_.empty()) {
+            reserve(initial_capacity_);
+        }
+        entries_.emplace_back(std::forward<K>(key), std::forward<V>(value));
+        const auto &name = entries_.back().first;
+        auto h = case_ignore::fast_hash(name.data(), name.size());
+        hashes_.push_back(h);
+
+        // Move behind the last field of the same name, usually there is none
+        auto last = entries_.size() - 1;
+        for (auto i = last; i > 0; --i) {
+            if (hashes_[i - 1] == h && case_ignore::fast_equal(entries_[i - 1].first, name)) {
+                std::rotate(entries_.begin() + static_cast<std::ptrdiff_t>(i), entries_.end() - 1, entries_.end());
+                std::rotate(hashes_.begin() + static_cast<std::ptrdiff_t>(i), hashes_.end() - 1, hashes_.end());
+                return entries_.begin() + static_cast<std::ptrdiff_t>(i);
+            }
+        }
+        return entries_.begin() + static_cast<std::ptrdiff_t>(last);
+    }
+
+    iterator insert(const value_type &kv) { return emplace(kv.first, kv.second); }
+    iterator insert(value_type &&kv) { return emplace(std::move(kv.first), std::move(kv.second)); }
+
+    template <typename It>
+    void insert(It first, It last) {
+        for (; first != last; ++first) {
+            emplace(first->first, first->second);
+        }
+    }
+
+    iterator find(const std::string &key) { return begin() + static_cast<std::ptrdiff_t>(find_index(key)); }
+    const_iterator find(const std::string &key) const {
+        return begin() + static_cast<std::ptrdiff_t>(find_index(key));
+    }
+
+    size_t count(const std::string &key) const {
+        auto r = range_index(key);
+        return r.second - r.first;
+    }
+
+    std::pair<iterator, iterator> equal_range(const std::string &key) {
+        auto r = range_index(key);
+        return std::make_pair(begin() + static_cast<std::ptrdiff_t>(r.first),
+                              begin() + static_cast<std::ptrdiff_t>(r.second));
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const std::string &key) const {
+        auto r = range_index(key);
+        return std::make_pair(begin() + static_cast<std::ptrdiff_t>(r.first),
+                              begin() + static_cast<std::ptrdiff_t>(r.second));
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    iterator erase(const_iterator first, const_iterator last) {
+        hashes_.erase(hashes_.begin() + (first - cbegin()), hashes_.begin() + (last - cbegin()));
+        return entries_.erase(first, last);
+    }
+    size_t erase(const std::string &key) {
+        auto r = equal_range(key);
+        auto n = static_cast<size_t>(r.second - r.first);
+        erase(r.first, r.second);
+        return n;
+    }
+
+private:
+    static constexpr size_t initial_capacity_ = 16;
+
+    size_t find_index(const std::string &key) const {
+        auto h = case_ignore::fast_hash(key.data(), key.size());
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            if (hashes_[i] == h && case_ignore::fast_equal(entries_[i].first, key)) {
+                return i;
+            }
+        }
+        return entries_.size();
+    }
+
+    std::pair<size_t, size_t> range_index(const std::string &key) const {
+        auto first = find_index(key);
+        auto last = first;
+        while (last < entries_.size() && hashes_[last] == hashes_[first] &&
+               case_ignore::fast_equal(entries_[last].first, key)) {
+            ++last;
+        }
+        return std::make_pair(first, last);
+    }
+
+    std::vector<value_type> entries_;
+    std::vector<size_t> hashes_;
+};
+
 // This is based on
 // "http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2014/n4189".
 
@@ -513,8 +710,12 @@ enum StatusCode {
     NetworkAuthenticationRequired_511 = 511,
 };
 
+#ifdef CPPHTTPLIB_FLAT_HEADERS
+using Headers = detail::FlatHeaders;
+#else
 using Headers =
     std::unordered_multimap<std::string, std::string, detail::case_ignore::hash, detail::case_ignore::equal_to>;
+#endif
 
 using Params = std::multimap<std::string, std::string>;
 using Match = std::smatch;
@@ -668,6 +869,10 @@ struct Request {
     std::chrono::time_point<std::chrono::steady_clock> start_time_ = (std::chrono::steady_clock::time_point::min)();
 };
 
+namespace detail {
+class mmap;
+}  // namespace detail
+
 struct Response {
     std::string version;
     int status = -1;
@@ -722,6 +927,7 @@ struct Response {
     bool content_provider_success_ = false;
     std::string file_content_path_;
     std::string file_content_content_type_;
+    std::shared_ptr<detail::mmap> content_file_;
 };
 
 class Stream {
@@ -740,6 +946,10 @@ public:
 
     virtual time_t duration() const = 0;
 
+    // Copy size bytes of the file at offset to the peer inside the kernel,
+    // -1 with nothing sent where the stream can't do that
+    virtual ssize_t send_file(int fd, size_t offset, size_t size);
+
     ssize_t write(const char *ptr);
     ssize_t write(const std::string &s);
 };
@@ -814,7 +1024,7 @@ private:
                         break;
                     }
 
-                    fn = pool_.jobs_.front();
+                    fn = std::move(pool_.jobs_.front());
                     pool_.jobs_.pop_front();
                 }
 
@@ -841,6 +1051,141 @@ private:
     std::mutex mutex_;
 };
 
+/*
+ * Thread pool on a bounded lock-free multi-producer multi-consumer ring
+ * (Vyukov). Jobs are moved into preallocated slots, so enqueue neither
+ * allocates nor locks unless a worker sleeps. Unlike ThreadPool the queue is
+ * always bounded, it holds mqr jobs or CPPHTTPLIB_RING_THREAD_POOL_CAPACITY
+ * when mqr is 0 and rejects connections beyond that.
+ */
+class RingThreadPool final : public TaskQueue {
+public:
+    explicit RingThreadPool(size_t n, size_t mqr = 0)
+        : capacity_(mqr > 0 ? mqr : CPPHTTPLIB_RING_THREAD_POOL_CAPACITY),
+          slots_(new slot[capacity_]) {
+        for (size_t i = 0; i < capacity_; i++) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+        while (n) {
+            threads_.emplace_back([this] { worker(); });
+            n--;
+        }
+    }
+
+    RingThreadPool(const RingThreadPool &) = delete;
+    ~RingThreadPool() override = default;
+
+    bool enqueue(std::function<void()> fn) override {
+        if (!try_push(fn)) {
+            return false;
+        }
+
+        // Pairs with the fence in worker(), either the worker sees the job or
+        // we see the sleeper
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cond_.notify_one();
+        }
+        return true;
+    }
+
+    void shutdown() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            shutdown_ = true;
+        }
+
+        cond_.notify_all();
+
+        for (auto &t : threads_) {
+            t.join();
+        }
+    }
+
+private:
+    struct alignas(64) slot {
+        std::atomic<size_t> seq{0};
+        std::function<void()> fn;
+    };
+
+    bool try_push(std::function<void()> &fn) {
+        auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto &s = slots_[pos % capacity_];
+            auto seq = s.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    s.fn = std::move(fn);
+                    s.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(std::function<void()> &fn) {
+        auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            auto &s = slots_[pos % capacity_];
+            auto seq = s.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    fn = std::move(s.fn);
+                    s.fn = nullptr;
+                    s.seq.store(pos + capacity_, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void worker() {
+        for (;;) {
+            std::function<void()> fn;
+            if (!try_pop(fn)) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                sleepers_.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                cond_.wait(lock, [&] { return try_pop(fn) || shutdown_; });
+                sleepers_.fetch_sub(1, std::memory_order_relaxed);
+
+                if (!fn) {
+                    break;  // Shut down and drained
+                }
+            }
+
+            fn();
+        }
+
+#if defined(CPPHTTPLIB_OPENSSL_SUPPORT) && !defined(OPENSSL_IS_BORINGSSL) && !defined(LIBRESSL_VERSION_NUMBER)
+        OPENSSL_thread_stop();
+#endif
+    }
+
+    const size_t capacity_;
+    std::unique_ptr<slot[]> slots_;
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+    alignas(64) std::atomic<size_t> sleepers_{0};
+
+    std::vector<std::thread> threads_;
+    bool shutdown_ = false;
+
+    std::condition_variable cond_;
+    std::mutex mutex_;
+};
+
 using Logger = std::function<void(const Request &, const Response &)>;
 
 using SocketOptions = std::function<void(socket_t sock)>;
@@ -861,6 +1206,118 @@ std::string get_bearer_token_auth(const Request &req);
 
 namespace detail {
 
+/**
+ * File descriptor that turns readable once notify() was called and stays so until reset().
+ * Used to wake up threads blocked in poll or epoll_wait. Not available on Windows.
+ */
+class WakeupEvent {
+public:
+    WakeupEvent();
+    ~WakeupEvent();
+
+    WakeupEvent(const WakeupEvent &) = delete;
+    WakeupEvent &operator=(const WakeupEvent &) = delete;
+
+    bool is_valid() const { return read_fd_ != INVALID_SOCKET; }
+    socket_t fd() const { return read_fd_; }
+
+    void notify();
+    void reset();
+
+private:
+    socket_t read_fd_ = INVALID_SOCKET;
+    socket_t write_fd_ = INVALID_SOCKET;
+};
+
+struct FileStat;
+class CompressionCache;
+
+/**
+ * LRU cache of mapped static files keyed by path, bounded by mapped bytes and
+ * by CPPHTTPLIB_FILE_CACHE_MAX_ENTRIES open descriptors. Within the
+ * revalidation interval a hit costs no syscall, after it the entry is kept
+ * only while inode, size, mtime and ctime are unchanged, compared in
+ * nanoseconds where the platform provides them.
+ */
+class FileCache {
+public:
+    struct Entry {
+        std::shared_ptr<mmap> file;
+        std::string content_type;
+        std::string etag;
+        std::string last_modified;
+    };
+
+    FileCache(size_t max_bytes, time_t revalidate_msec);
+
+    // Entry checked within the revalidation interval
+    std::shared_ptr<const Entry> find(const std::string &path);
+    // Entry still matching stat, restarts its revalidation interval
+    std::shared_ptr<const Entry> find(const std::string &path, const FileStat &stat);
+    // Entry for the file, cached unless it exceeds the byte budget
+    std::shared_ptr<const Entry> insert(const std::string &path,
+                                        const FileStat &stat,
+                                        std::shared_ptr<mmap> file,
+                                        std::string content_type);
+    void clear();
+
+private:
+    struct Node {
+        std::string path;
+        std::shared_ptr<const Entry> entry;
+        uint64_t ino;
+        size_t size;
+        uint64_t mtime_ns;
+        uint64_t ctime_ns;
+        std::chrono::steady_clock::time_point checked;
+    };
+
+    void erase(std::list<Node>::iterator it);
+
+    const size_t max_bytes_;
+    const std::chrono::milliseconds revalidate_interval_;
+
+    std::mutex mutex_;
+    std::list<Node> lru_;
+    std::unordered_map<std::string, std::list<Node>::iterator> index_;
+    size_t bytes_ = 0;
+};
+
+/**
+ * Radix tree over route patterns of one method. Holds the patterns a
+ * PathParamsMatcher accepts and regex patterns without metacharacters, which
+ * are plain literals. Everything else is kept as a regex route. find() returns
+ * the same route a scan in registration order would, at the cost of one walk
+ * down the tree plus the regex routes registered before the tree candidate.
+ */
+class RouteTree {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    void add(const std::string &pattern, size_t route);
+
+    // First route in registration order for which match(route) holds. It is
+    // called for the tree candidate and regex routes registered before it.
+    template <typename T>
+    size_t find(const std::string &path, T match) const;
+
+private:
+    struct Node {
+        std::string label;
+        std::vector<std::unique_ptr<Node>> children;
+        std::unique_ptr<Node> param;
+        size_t route = npos;
+        size_t min_route = npos;
+    };
+
+    static bool is_literal(const std::string &pattern);
+    static Node *add_static(Node *node, const std::string &fragment, size_t route);
+    void search(const Node &node, const std::string &path, size_t pos, size_t &best) const;
+
+    Node root_;
+    std::vector<size_t> regex_routes_;
+};
+
 class MatcherBase {
 public:
     MatcherBase(std::string pattern)
@@ -980,6 +1437,20 @@ public:
     Server &set_default_file_mimetype(const std::string &mime);
     Server &set_file_request_handler(Handler handler);
 
+    // Keep up to max_bytes of mapped mount point files with their Content-Type,
+    // ETag and Last-Modified, 0 disables. Matching If-None-Match or
+    // If-Modified-Since requests get 304. Changed files are noticed after at
+    // most revalidate_msec, replace files by rename rather than rewriting them.
+    Server &set_file_cache(size_t max_bytes, time_t revalidate_msec = CPPHTTPLIB_FILE_CACHE_REVALIDATE_MSEC);
+
+    // Serve a sibling .br, .zst or .gz of a compressible mount point file when
+    // Accept-Encoding allows it. Needs no compression library.
+    Server &set_precompressed_files(bool on);
+
+    // Reuse compressed response bodies with identical content, up to max_bytes
+    // of originals and compressed copies, 0 disables.
+    Server &set_compression_cache(size_t max_bytes);
+
     template <class ErrorHandlerFunc>
     Server &set_error_handler(ErrorHandlerFunc &&handler) {
         return set_error_handler_core(std::forward<ErrorHandlerFunc>(handler),
@@ -1007,6 +1478,21 @@ public:
     Server &set_keep_alive_max_count(size_t count);
     Server &set_keep_alive_timeout(time_t sec);
 
+    // Park idle keep-alive connections in epoll instead of blocking a task queue
+    // thread per connection. Linux only and ignored by SSLServer.
+    Server &set_event_loop(bool on);
+
+    // Open count listening sockets sharing the port through SO_REUSEPORT, each
+    // with its own acceptor thread. Every acceptor creates its own task queue
+    // through new_task_queue, so count acceptors run count times its workers,
+    // size the queue per acceptor. With pin_to_cores every acceptor runs on a
+    // spawned thread pinned to a distinct core out of the CPUs the process may
+    // use, the thread calling listen() keeps its affinity. If one acceptor
+    // fails the whole server stops and listen() returns false. Call before
+    // binding.
+    Server &set_acceptor_count(size_t count, bool pin_to_cores = false);
+    Server &set_listen_backlog(int backlog);
+
     Server &set_read_timeout(time_t sec, time_t usec = 0);
     template <class Rep, class Period>
     Server &set_read_timeout(const std::chrono::duration<Rep, Period> &duration);
@@ -1045,6 +1531,8 @@ protected:
                          const std::function<void(Request &)> &setup_request);
 
     std::atomic<socket_t> svr_sock_{INVALID_SOCKET};
+    // Readable once stop() was called, wakes up threads waiting for keep-alive requests
+    detail::WakeupEvent stop_event_;
     size_t keep_alive_max_count_ = CPPHTTPLIB_KEEPALIVE_MAX_COUNT;
     time_t keep_alive_timeout_sec_ = CPPHTTPLIB_KEEPALIVE_TIMEOUT_SECOND;
     time_t read_timeout_sec_ = CPPHTTPLIB_SERVER_READ_TIMEOUT_SECOND;
@@ -1056,9 +1544,18 @@ protected:
     size_t payload_max_length_ = CPPHTTPLIB_PAYLOAD_MAX_LENGTH;
 
 private:
-    using Handlers = std::vector<std::pair<std::unique_ptr<detail::MatcherBase>, Handler>>;
-    using HandlersForContentReader =
-        std::vector<std::pair<std::unique_ptr<detail::MatcherBase>, HandlerWithContentReader>>;
+    template <typename T>
+    struct Routes {
+        std::vector<std::pair<std::unique_ptr<detail::MatcherBase>, T>> handlers;
+        detail::RouteTree tree;
+
+        void add(const std::string &pattern, T handler) {
+            tree.add(pattern, handlers.size());
+            handlers.emplace_back(make_matcher(pattern), std::move(handler));
+        }
+    };
+    using Handlers = Routes<Handler>;
+    using HandlersForContentReader = Routes<HandlerWithContentReader>;
 
     static std::unique_ptr<detail::MatcherBase> make_matcher(const std::string &pattern);
 
@@ -1071,9 +1568,16 @@ private:
                                   SocketOptions socket_options) const;
     int bind_internal(const std::string &host, int port, int socket_flags);
     bool listen_internal();
+    bool serve_socket(socket_t listen_sock);
+    bool run_event_loop(socket_t listen_sock, TaskQueue &task_queue);
+    void close_reuse_port_sockets();
+    virtual bool supports_event_loop() const { return true; }
 
     bool routing(Request &req, Response &res, Stream &strm);
     bool handle_file_request(const Request &req, Response &res);
+    std::shared_ptr<const detail::FileCache::Entry> find_file(const std::string &path,
+                                                              const std::string &content_type_path,
+                                                              bool &is_dir);
     bool dispatch_request(Request &req, Response &res, const Handlers &handlers) const;
     bool dispatch_request_for_content_reader(Request &req,
                                              Response &res,
@@ -1106,6 +1610,11 @@ private:
 
     std::atomic<bool> is_running_{false};
     std::atomic<bool> is_decommissioned{false};
+    bool event_loop_ = false;
+    size_t acceptor_count_ = 1;
+    bool pin_acceptors_ = false;
+    int listen_backlog_ = CPPHTTPLIB_LISTEN_BACKLOG;
+    std::vector<socket_t> reuse_port_socks_;
 
     struct MountPointEntry {
         std::string mount_point;
@@ -1116,6 +1625,9 @@ private:
     std::map<std::string, std::string> file_extension_and_mimetype_map_;
     std::string default_file_mimetype_ = "application/octet-stream";
     Handler file_request_handler_;
+    std::unique_ptr<detail::FileCache> file_cache_;
+    bool precompressed_files_ = false;
+    std::unique_ptr<detail::CompressionCache> compression_cache_;
 
     Handlers get_handlers_;
     Handlers post_handlers_;
@@ -2036,6 +2548,7 @@ public:
 
 private:
     bool process_and_close_socket(socket_t sock) override;
+    bool supports_event_loop() const override { return false; }
 
     SSL_CTX *ctx_;
     std::mutex ctx_mutex_;
@@ -2489,6 +3002,12 @@ struct FileStat {
     FileStat(const std::string &path);
     bool is_file() const;
     bool is_dir() const;
+    size_t size() const;
+    time_t mtime() const;
+    // Nanoseconds since the epoch, whole seconds on Windows
+    uint64_t mtime_ns() const;
+    uint64_t ctime_ns() const;
+    uint64_t ino() const;
 
 private:
 #if defined(_WIN32)
@@ -2724,6 +3243,7 @@ public:
     bool is_open() const;
     size_t size() const;
     const char *data() const;
+    int fd() const;
 
 private:
 #if defined(_WIN32)
@@ -2969,6 +3489,24 @@ inline FileStat::FileStat(const std::string &path) {
 }
 inline bool FileStat::is_file() const { return ret_ >= 0 && S_ISREG(st_.st_mode); }
 inline bool FileStat::is_dir() const { return ret_ >= 0 && S_ISDIR(st_.st_mode); }
+inline size_t FileStat::size() const { return ret_ >= 0 ? static_cast<size_t>(st_.st_size) : 0; }
+inline time_t FileStat::mtime() const { return ret_ >= 0 ? st_.st_mtime : 0; }
+#if defined(_WIN32)
+inline uint64_t FileStat::mtime_ns() const { return ret_ >= 0 ? static_cast<uint64_t>(st_.st_mtime) * 1000000000 : 0; }
+inline uint64_t FileStat::ctime_ns() const { return ret_ >= 0 ? static_cast<uint64_t>(st_.st_ctime) * 1000000000 : 0; }
+#else
+inline uint64_t timespec_to_ns(const struct timespec &ts) {
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + static_cast<uint64_t>(ts.tv_nsec);
+}
+    #if defined(__APPLE__)
+inline uint64_t FileStat::mtime_ns() const { return ret_ >= 0 ? timespec_to_ns(st_.st_mtimespec) : 0; }
+inline uint64_t FileStat::ctime_ns() const { return ret_ >= 0 ? timespec_to_ns(st_.st_ctimespec) : 0; }
+    #else
+inline uint64_t FileStat::mtime_ns() const { return ret_ >= 0 ? timespec_to_ns(st_.st_mtim) : 0; }
+inline uint64_t FileStat::ctime_ns() const { return ret_ >= 0 ? timespec_to_ns(st_.st_ctim) : 0; }
+    #endif
+#endif
+inline uint64_t FileStat::ino() const { return ret_ >= 0 ? static_cast<uint64_t>(st_.st_ino) : 0; }
 
 inline std::string encode_query_param(const std::string &value) {
     std::ostringstream escaped;
@@ -3335,6 +3873,14 @@ inline size_t mmap::size() const { return size_; }
 
 inline const char *mmap::data() const { return is_open_empty_file ? "" : static_cast<const char *>(addr_); }
 
+inline int mmap::fd() const {
+#if defined(_WIN32)
+    return -1;
+#else
+    return fd_;
+#endif
+}
+
 inline void mmap::close() {
 #if defined(_WIN32)
     if (addr_) {
@@ -3366,6 +3912,126 @@ inline void mmap::close() {
 #endif
     size_ = 0;
 }
+
+// IMF-fixdate, formatted by hand to stay independent of the C locale
+inline std::string make_http_date(time_t t) {
+    static const char *days[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    static const char *months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                   "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+    struct tm tm {};
+#if defined(_WIN32)
+    gmtime_s(&tm, &t);
+#else
+    gmtime_r(&t, &tm);
+#endif
+
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%s, %02d %s %04d %02d:%02d:%02d GMT", days[tm.tm_wday % 7], tm.tm_mday,
+             months[tm.tm_mon % 12], tm.tm_year + 1900, tm.tm_hour, tm.tm_min, tm.tm_sec);
+    return buf;
+}
+
+// Weak comparison as If-None-Match requires, a W/ prefix on either side is ignored
+inline bool etag_matches(const std::string &if_none_match, const std::string &etag) {
+    auto opaque = [](const char *b, const char *e) {
+        if (e - b >= 2 && b[0] == 'W' && b[1] == '/') {
+            b += 2;
+        }
+        return std::string(b, e);
+    };
+
+    auto target = opaque(etag.data(), etag.data() + etag.size());
+    auto matched = false;
+    split(if_none_match.data(), if_none_match.data() + if_none_match.size(), ',', [&](const char *b, const char *e) {
+        matched = matched || (e - b == 1 && *b == '*') || opaque(b, e) == target;
+    });
+    return matched;
+}
+
+inline FileCache::FileCache(size_t max_bytes, time_t revalidate_msec)
+    : max_bytes_(max_bytes),
+      revalidate_interval_(revalidate_msec) {}
+
+inline std::shared_ptr<const FileCache::Entry> FileCache::find(const std::string &path) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = index_.find(path);
+    if (it == index_.end() || std::chrono::steady_clock::now() - it->second->checked >= revalidate_interval_) {
+        return nullptr;
+    }
+
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->entry;
+}
+
+inline std::shared_ptr<const FileCache::Entry> FileCache::find(const std::string &path, const FileStat &stat) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = index_.find(path);
+    if (it == index_.end()) {
+        return nullptr;
+    }
+
+    auto node = it->second;
+    if (node->ino != stat.ino() || node->size != stat.size() || node->mtime_ns != stat.mtime_ns() ||
+        node->ctime_ns != stat.ctime_ns()) {
+        erase(node);
+        return nullptr;
+    }
+
+    node->checked = std::chrono::steady_clock::now();
+    lru_.splice(lru_.begin(), lru_, node);
+    return node->entry;
+}
+
+inline std::shared_ptr<const FileCache::Entry> FileCache::insert(const std::string &path,
+                                                                 const FileStat &stat,
+                                                                 std::shared_ptr<mmap> file,
+                                                                 std::string content_type) {
+    auto size = file->size();
+
+    auto entry = std::make_shared<Entry>();
+    entry->file = std::move(file);
+    entry->content_type = std::move(content_type);
+
+    char etag[64];
+    snprintf(etag, sizeof(etag), "\"%llx-%llx-%llx\"", static_cast<unsigned long long>(stat.ino()),
+             static_cast<unsigned long long>(stat.mtime_ns()), static_cast<unsigned long long>(size));
+    entry->etag = etag;
+    entry->last_modified = make_http_date(stat.mtime());
+
+    if (size > max_bytes_) {
+        return entry;
+    }
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = index_.find(path);
+    if (it != index_.end()) {
+        erase(it->second);
+    }
+
+    lru_.push_front(
+        Node{path, entry, stat.ino(), size, stat.mtime_ns(), stat.ctime_ns(), std::chrono::steady_clock::now()});
+    index_.emplace(path, lru_.begin());
+    bytes_ += size;
+
+    while (bytes_ > max_bytes_ || lru_.size() > CPPHTTPLIB_FILE_CACHE_MAX_ENTRIES) {
+        erase(std::prev(lru_.end()));
+    }
+    return entry;
+}
+
+inline void FileCache::clear() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    lru_.clear();
+    index_.clear();
+    bytes_ = 0;
+}
+
+inline void FileCache::erase(std::list<Node>::iterator it) {
+    bytes_ -= it->size;
+    index_.erase(it->path);
+    lru_.erase(it);
+}
 inline int close_socket(socket_t sock) {
 #ifdef _WIN32
     return closesocket(sock);
@@ -3459,27 +4125,109 @@ inline Error wait_until_socket_is_ready(socket_t sock, time_t sec, time_t usec)
     return Error::Connection;
 }
 
-inline bool is_socket_alive(socket_t sock) {
-    const auto val = detail::select_read(sock, 0, 0);
-    if (val == 0) {
-        return true;
-    } else if (val < 0 && errno == EBADF) {
-        return false;
+// Pins the calling thread to the index-th CPU, modulo their count, out of the
+// CPUs it may currently run on, so cpusets and taskset masks are respected
+inline void pin_thread_to_core(size_t index) {
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(allowed), &allowed) != 0) {
+        return;
     }
-    char buf[1];
-    return detail::read_socket(sock, &buf[0], sizeof(buf), MSG_PEEK) > 0;
+    const auto count = CPU_COUNT(&allowed);
+    if (count <= 0) {
+        return;
+    }
+
+    auto nth = static_cast<int>(index % static_cast<size_t>(count));
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &allowed) && nth-- == 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            return;
+        }
+    }
+#else
+    (void)index;
+#endif
 }
 
-class SocketStream final : public Stream {
-public:
-    SocketStream(
-        socket_t sock,
-        time_t read_timeout_sec,
-        time_t read_timeout_usec,
-        time_t write_timeout_sec,
-        time_t write_timeout_usec,
-        time_t max_timeout_msec = 0,
-        std::chrono::time_point<std::chrono::steady_clock> start_time = (std::chrono::steady_clock::time_point::min)());
+inline WakeupEvent::WakeupEvent() {
+#if defined(__linux__)
+    read_fd_ = write_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+#elif !defined(_WIN32)
+    int fds[2];
+    if (pipe(fds) == 0) {
+        for (auto fd : fds) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        read_fd_ = fds[0];
+        write_fd_ = fds[1];
+    }
+#endif
+}
+
+inline WakeupEvent::~WakeupEvent() {
+#ifndef _WIN32
+    if (read_fd_ != INVALID_SOCKET) {
+        close(read_fd_);
+    }
+    if (write_fd_ != INVALID_SOCKET && write_fd_ != read_fd_) {
+        close(write_fd_);
+    }
+#endif
+}
+
+inline void WakeupEvent::notify() {
+#ifndef _WIN32
+    if (write_fd_ == INVALID_SOCKET) {
+        return;
+    }
+    // A full eventfd counter or pipe means the event is already pending
+    #ifdef __linux__
+    uint64_t one = 1;
+    #else
+    char one = 1;
+    #endif
+    handle_EINTR([&]() { return ::write(write_fd_, &one, sizeof(one)); });
+#endif
+}
+
+inline void WakeupEvent::reset() {
+#ifndef _WIN32
+    if (read_fd_ == INVALID_SOCKET) {
+        return;
+    }
+    char buf[64];
+    while (handle_EINTR([&]() { return ::read(read_fd_, buf, sizeof(buf)); }) > 0) {
+    }
+#endif
+}
+
+inline bool is_socket_alive(socket_t sock) {
+    const auto val = detail::select_read(sock, 0, 0);
+    if (val == 0) {
+        return true;
+    } else if (val < 0 && errno == EBADF) {
+        return false;
+    }
+    char buf[1];
+    return detail::read_socket(sock, &buf[0], sizeof(buf), MSG_PEEK) > 0;
+}
+
+class SocketStream final : public Stream {
+public:
+    SocketStream(
+        socket_t sock,
+        time_t read_timeout_sec,
+        time_t read_timeout_usec,
+        time_t write_timeout_sec,
+        time_t write_timeout_usec,
+        time_t max_timeout_msec = 0,
+        std::chrono::time_point<std::chrono::steady_clock> start_time = (std::chrono::steady_clock::time_point::min)());
     ~SocketStream() override;
 
     bool is_readable() const override;
@@ -3491,6 +4239,7 @@ public:
     void get_local_ip_and_port(std::string &ip, int &port) const override;
     socket_t socket() const override;
     time_t duration() const override;
+    ssize_t send_file(int fd, size_t offset, size_t size) override;
 
 private:
     socket_t sock_;
@@ -3544,9 +4293,52 @@ private:
 };
 #endif
 
-inline bool keep_alive(const std::atomic<socket_t> &svr_sock, socket_t sock, time_t keep_alive_timeout_sec) {
+inline bool keep_alive(const std::atomic<socket_t> &svr_sock,
+                       socket_t stop_fd,
+                       socket_t sock,
+                       time_t keep_alive_timeout_sec) {
     using namespace std::chrono;
 
+#ifndef _WIN32
+    // Block until data arrives, the timeout expires or stop_fd signals the server shutdown
+    if (stop_fd != INVALID_SOCKET) {
+        const auto deadline = steady_clock::now() + seconds{keep_alive_timeout_sec};
+        // Like the polling loop below, the first poll waits at least one check
+        // interval, so a timeout of 0 still serves a request on its way
+        auto first_poll = true;
+        while (svr_sock != INVALID_SOCKET) {
+            auto remaining = ceil<milliseconds>(deadline - steady_clock::now()).count();
+            if (first_poll) {
+                const auto interval =
+                    ceil<milliseconds>(microseconds{CPPHTTPLIB_KEEPALIVE_TIMEOUT_CHECK_INTERVAL_USECOND});
+                remaining = (std::max)(remaining, static_cast<decltype(remaining)>(interval.count()));
+                first_poll = false;
+            } else if (remaining <= 0) {
+                break;  // Timeout
+            }
+
+            struct pollfd pfds[2];
+            pfds[0].fd = sock;
+            pfds[0].events = POLLIN;
+            pfds[0].revents = 0;
+            pfds[1].fd = stop_fd;
+            pfds[1].events = POLLIN;
+            pfds[1].revents = 0;
+
+            auto val = poll_wrapper(pfds, 2, static_cast<int>(remaining));
+            if (val < 0 && errno == EINTR) {
+                continue;
+            } else if (val <= 0 || pfds[1].revents) {
+                break;  // Socket error, timeout or server stopped
+            }
+            return pfds[0].revents != 0;
+        }
+        return false;
+    }
+#else
+    (void)stop_fd;
+#endif
+
     const auto interval_usec = CPPHTTPLIB_KEEPALIVE_TIMEOUT_CHECK_INTERVAL_USECOND;
 
     // Avoid expensive `steady_clock::now()` call for the first time
@@ -3579,6 +4371,7 @@ inline bool keep_alive(const std::atomic<socket_t> &svr_sock, socket_t sock, tim
 
 template <typename T>
 inline bool process_server_socket_core(const std::atomic<socket_t> &svr_sock,
+                                       socket_t stop_fd,
                                        socket_t sock,
                                        size_t keep_alive_max_count,
                                        time_t keep_alive_timeout_sec,
@@ -3586,7 +4379,7 @@ inline bool process_server_socket_core(const std::atomic<socket_t> &svr_sock,
     assert(keep_alive_max_count > 0);
     auto ret = false;
     auto count = keep_alive_max_count;
-    while (count > 0 && keep_alive(svr_sock, sock, keep_alive_timeout_sec)) {
+    while (count > 0 && keep_alive(svr_sock, stop_fd, sock, keep_alive_timeout_sec)) {
         auto close_connection = count == 1;
         auto connection_closed = false;
         ret = callback(close_connection, connection_closed);
@@ -3600,6 +4393,7 @@ inline bool process_server_socket_core(const std::atomic<socket_t> &svr_sock,
 
 template <typename T>
 inline bool process_server_socket(const std::atomic<socket_t> &svr_sock,
+                                  socket_t stop_fd,
                                   socket_t sock,
                                   size_t keep_alive_max_count,
                                   time_t keep_alive_timeout_sec,
@@ -3608,7 +4402,7 @@ inline bool process_server_socket(const std::atomic<socket_t> &svr_sock,
                                   time_t write_timeout_sec,
                                   time_t write_timeout_usec,
                                   T callback) {
-    return process_server_socket_core(svr_sock, sock, keep_alive_max_count, keep_alive_timeout_sec,
+    return process_server_socket_core(svr_sock, stop_fd, sock, keep_alive_max_count, keep_alive_timeout_sec,
                                       [&](bool close_connection, bool &connection_closed) {
                                           SocketStream strm(sock, read_timeout_sec, read_timeout_usec,
                                                             write_timeout_sec, write_timeout_usec);
@@ -4205,6 +4999,106 @@ inline EncodingType encoding_type(const Request &req, const Response &res) {
     return EncodingType::None;
 }
 
+// True if the Accept-Encoding value lists coding without q=0, "*" only
+// counts when coding itself is not listed
+inline bool accepts_encoding(const std::string &accept_encoding, const std::string &coding) {
+    // -1 while not listed
+    auto coding_q = -1.0;
+    auto any_q = -1.0;
+    const auto *end = accept_encoding.data() + accept_encoding.size();
+    split(accept_encoding.data(), end, ',', [&](const char *b, const char *e) {
+        std::string item(b, e);
+        auto semi = item.find(';');
+        auto name = trim_copy(item.substr(0, semi));
+        auto is_coding = case_ignore::equal(name, coding);
+        if (!is_coding && name != "*") {
+            return;
+        }
+
+        auto q = 1.0;
+        if (semi != std::string::npos) {
+            split(item.data() + semi + 1, item.data() + item.size(), ';', [&](const char *pb, const char *pe) {
+                std::string param(pb, pe);
+                auto eq = param.find('=');
+                if (eq != std::string::npos && case_ignore::equal(trim_copy(param.substr(0, eq)), "q")) {
+                    q = std::strtod(param.c_str() + eq + 1, nullptr);
+                }
+            });
+        }
+        auto &listed = is_coding ? coding_q : any_q;
+        listed = (std::max)(listed, q);
+    });
+    return coding_q >= 0 ? coding_q > 0 : any_q > 0;
+}
+
+/**
+ * LRU cache of compressed response bodies keyed by a hash of the original.
+ * Originals are kept to rule out hash collisions and count towards the byte
+ * budget together with the compressed copies.
+ */
+class CompressionCache {
+public:
+    explicit CompressionCache(size_t max_bytes)
+        : max_bytes_(max_bytes) {}
+
+    bool find(EncodingType type, const std::string &body, std::string &compressed) {
+        auto hash = std::hash<std::string>()(body);
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto range = index_.equal_range(key(type, hash));
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second->body == body) {
+                lru_.splice(lru_.begin(), lru_, it->second);
+                compressed = it->second->compressed;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void insert(EncodingType type, const std::string &body, const std::string &compressed) {
+        auto size = body.size() + compressed.size();
+        if (size > max_bytes_) {
+            return;
+        }
+        auto k = key(type, std::hash<std::string>()(body));
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        lru_.push_front(Node{k, body, compressed});
+        index_.emplace(k, lru_.begin());
+        bytes_ += size;
+
+        while (bytes_ > max_bytes_) {
+            auto last = std::prev(lru_.end());
+            auto range = index_.equal_range(last->key);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == last) {
+                    index_.erase(it);
+                    break;
+                }
+            }
+            bytes_ -= last->body.size() + last->compressed.size();
+            lru_.erase(last);
+        }
+    }
+
+private:
+    struct Node {
+        size_t key;
+        std::string body;
+        std::string compressed;
+    };
+
+    static size_t key(EncodingType type, size_t hash) { return hash * 31 + static_cast<size_t>(type); }
+
+    const size_t max_bytes_;
+
+    std::mutex mutex_;
+    std::list<Node> lru_;
+    std::unordered_multimap<size_t, std::list<Node>::iterator> index_;
+    size_t bytes_ = 0;
+};
+
 inline bool nocompressor::compress(const char *data, size_t data_length, bool /*last*/, Callback callback) {
     if (!data_length) {
         return true;
@@ -4870,6 +5764,21 @@ inline bool write_data(Stream &strm, const char *d, size_t l) {
     return true;
 }
 
+// Returns the bytes sent, less than length if the transfer failed and 0 if
+// the stream can't send files so the caller can fall back to a copy
+template <typename T>
+inline size_t send_file_content(Stream &strm, int fd, size_t offset, size_t length, const T &is_shutting_down) {
+    size_t sent = 0;
+    while (sent < length && !is_shutting_down()) {
+        auto n = strm.send_file(fd, offset + sent, length - sent);
+        if (n <= 0) {
+            break;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return sent;
+}
+
 template <typename T>
 inline bool write_content(Stream &strm,
                           const ContentProvider &content_provider,
@@ -6252,6 +7161,7 @@ inline void Response::set_content_provider(size_t in_length,
     }
     content_provider_resource_releaser_ = std::move(resource_releaser);
     is_chunked_content_provider_ = false;
+    content_file_.reset();
 }
 
 inline void Response::set_content_provider(const std::string &content_type,
@@ -6262,6 +7172,7 @@ inline void Response::set_content_provider(const std::string &content_type,
     content_provider_ = detail::ContentProviderAdapter(std::move(provider));
     content_provider_resource_releaser_ = std::move(resource_releaser);
     is_chunked_content_provider_ = false;
+    content_file_.reset();
 }
 
 inline void Response::set_chunked_content_provider(const std::string &content_type,
@@ -6272,6 +7183,7 @@ inline void Response::set_chunked_content_provider(const std::string &content_ty
     content_provider_ = detail::ContentProviderAdapter(std::move(provider));
     content_provider_resource_releaser_ = std::move(resource_releaser);
     is_chunked_content_provider_ = true;
+    content_file_.reset();
 }
 
 inline void Response::set_file_content(const std::string &path, const std::string &content_type) {
@@ -6300,6 +7212,8 @@ inline ssize_t Stream::write(const char *ptr) { return write(ptr, strlen(ptr));
 
 inline ssize_t Stream::write(const std::string &s) { return write(s.data(), s.size()); }
 
+inline ssize_t Stream::send_file(int /*fd*/, size_t /*offset*/, size_t /*size*/) { return -1; }
+
 namespace detail {
 
 inline void calc_actual_timeout(time_t max_timeout_msec,
@@ -6425,6 +7339,19 @@ inline void SocketStream::get_local_ip_and_port(std::string &ip, int &port) cons
 
 inline socket_t SocketStream::socket() const { return sock_; }
 
+inline ssize_t SocketStream::send_file(int fd, size_t offset, size_t size) {
+#ifdef __linux__
+    if (fd == -1 || !wait_writable()) {
+        return -1;
+    }
+
+    auto off = static_cast<off_t>(offset);
+    return handle_EINTR([&]() { return ::sendfile(sock_, fd, &off, size); });
+#else
+    return Stream::send_file(fd, offset, size);
+#endif
+}
+
 inline time_t SocketStream::duration() const {
     return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time_)
         .count();
@@ -6562,6 +7489,135 @@ inline bool RegexMatcher::match(Request &request) const {
     return std::regex_match(request.path, request.matches, regex_);
 }
 
+inline bool RouteTree::is_literal(const std::string &pattern) {
+    return pattern.find_first_of("\\^$.|?*+()[]{}") == std::string::npos;
+}
+
+inline RouteTree::Node *RouteTree::add_static(Node *node, const std::string &fragment, size_t route) {
+    size_t pos = 0;
+    while (pos < fragment.size()) {
+        node->min_route = (std::min)(node->min_route, route);
+
+        auto it = std::find_if(node->children.begin(), node->children.end(),
+                               [&](const std::unique_ptr<Node> &child) { return child->label[0] == fragment[pos]; });
+        if (it == node->children.end()) {
+            node->children.push_back(detail::make_unique<Node>());
+            node->children.back()->label = fragment.substr(pos);
+            return node->children.back().get();
+        }
+
+        auto &child = *it;
+        size_t common = 0;
+        while (common < child->label.size() && pos + common < fragment.size() &&
+               child->label[common] == fragment[pos + common]) {
+            common++;
+        }
+
+        // Split the edge at the first differing character
+        if (common < child->label.size()) {
+            auto split = detail::make_unique<Node>();
+            split->label = child->label.substr(0, common);
+            split->min_route = child->min_route;
+            child->label.erase(0, common);
+            split->children.push_back(std::move(child));
+            child = std::move(split);
+        }
+
+        node = child.get();
+        pos += common;
+    }
+    return node;
+}
+
+inline void RouteTree::add(const std::string &pattern, size_t route) {
+    auto has_params = pattern.find("/:") != std::string::npos;
+    if (!has_params && !is_literal(pattern)) {
+        regex_routes_.push_back(route);
+        return;
+    }
+
+    // Same fragments as PathParamsMatcher, a param runs up to the next '/'
+    auto node = &root_;
+    size_t pos = 0;
+    while (true) {
+        auto marker_pos = has_params ? pattern.find("/:", pos == 0 ? 0 : pos - 1) : std::string::npos;
+        if (marker_pos == std::string::npos) {
+            if (pos < pattern.size()) {
+                node = add_static(node, pattern.substr(pos), route);
+            }
+            break;
+        }
+
+        node = add_static(node, pattern.substr(pos, marker_pos - pos + 1), route);
+        node->min_route = (std::min)(node->min_route, route);
+        if (!node->param) {
+            node->param = detail::make_unique<Node>();
+        }
+        node = node->param.get();
+
+        auto sep_pos = pattern.find('/', marker_pos + 2);
+        pos = sep_pos == std::string::npos ? pattern.size() : sep_pos + 1;
+    }
+
+    node->min_route = (std::min)(node->min_route, route);
+    node->route = (std::min)(node->route, route);
+}
+
+inline void RouteTree::search(const Node &node, const std::string &path, size_t pos, size_t &best) const {
+    // pos passes the end of path by one after a param that ended the path
+    if (pos >= path.size() && node.route < best) {
+        best = node.route;
+    }
+
+    if (pos < path.size()) {
+        for (const auto &child : node.children) {
+            if (child->label[0] == path[pos]) {
+                if (child->min_route < best && !path.compare(pos, child->label.size(), child->label)) {
+                    search(*child, path, pos + child->label.size(), best);
+                }
+                break;
+            }
+        }
+    }
+
+    if (node.param && node.param->min_route < best && pos <= path.size()) {
+        auto sep_pos = path.find('/', pos);
+        search(*node.param, path, sep_pos == std::string::npos ? path.size() + 1 : sep_pos + 1, best);
+    }
+}
+
+template <typename T>
+inline size_t RouteTree::find(const std::string &path, T match) const {
+    auto candidate = npos;
+    if (root_.min_route != npos) {
+        search(root_, path, 0, candidate);
+    }
+
+    for (auto route : regex_routes_) {
+        if (route > candidate) {
+            break;
+        }
+        if (match(route)) {
+            return route;
+        }
+    }
+
+    if (candidate == npos) {
+        return npos;
+    }
+    if (match(candidate)) {
+        return candidate;
+    }
+
+    // The tree and the matcher disagree, fall back to the remaining regex routes
+    for (auto route : regex_routes_) {
+        if (route > candidate && match(route)) {
+            return route;
+        }
+    }
+    return npos;
+}
+
 }  // namespace detail
 
 // HTTP server implementation
@@ -6572,7 +7628,7 @@ inline Server::Server()
 #endif
 }
 
-inline Server::~Server() = default;
+inline Server::~Server() { close_reuse_port_sockets(); }
 
 inline std::unique_ptr<detail::MatcherBase> Server::make_matcher(const std::string &pattern) {
     if (pattern.find("/:") != std::string::npos) {
@@ -6583,52 +7639,52 @@ inline std::unique_ptr<detail::MatcherBase> Server::make_matcher(const std::stri
 }
 
 inline Server &Server::Get(const std::string &pattern, Handler handler) {
-    get_handlers_.emplace_back(make_matcher(pattern), std::move(handler));
+    get_handlers_.add(pattern, std::move(handler));
     return *this;
 }
 
 inline Server &Server::Post(const std::string &pattern, Handler handler) {
-    post_handlers_.emplace_back(make_matcher(pattern), std::move(handler));
+    post_handlers_.add(pattern, std::move(handler));
     return *this;
 }
 
 inline Server &Server::Post(const std::string &pattern, HandlerWithContentReader handler) {
-    post_handlers_for_content_reader_.emplace_back(make_matcher(pattern), std::move(handler));
+    post_handlers_for_content_reader_.add(pattern, std::move(handler));
     return *this;
 }
 
 inline Server &Server::Put(const std::string &pattern, Handler handler) {
-    put_handlers_.emplace_back(make_matcher(pattern), std::move(handler));
+    put_handlers_.add(pattern, std::move(handler));
     return *this;
 }
 
 inline Server &Server::Put(const std::string &pattern, HandlerWithContentReader handler) {
-    put_handlers_for_content_reader_.emplace_back(make_matcher(pattern), std::move(handler));
+    put_handlers_for_content_reader_.add(pattern, std::move(handler));
     return *this;
 }
 
 inline Server &Server::Patch(const std::string &pattern, Handler handler) {
-    patch_handlers_.emplace_back(make_matcher(pattern), std::move(handler));
+    patch_handlers_.add(pattern, std::move(handler));
     return *this;
 }
 
 inline Server &Server::Patch(const std::string &pattern, HandlerWithContentReader handler) {
-    patch_handlers_for_content_reader_.emplace_back(make_matcher(pattern), std::move(handler));
+    patch_handlers_for_content_reader_.add(pattern, std::move(handler));
     return *this;
 }
 
 inline Server &Server::Delete(const std::string &pattern, Handler handler) {
-    delete_handlers_.emplace_back(make_matcher(pattern), std::move(handler));
+    delete_handlers_.add(pattern, std::move(handler));
     return *this;
 }
 
 inline Server &Server::Delete(const std::string &pattern, HandlerWithContentReader handler) {
-    delete_handlers_for_content_reader_.emplace_back(make_matcher(pattern), std::move(handler));
+    delete_handlers_for_content_reader_.add(pattern, std::move(handler));
     return *this;
 }
 
 inline Server &Server::Options(const std::string &pattern, Handler handler) {
-    options_handlers_.emplace_back(make_matcher(pattern), std::move(handler));
+    options_handlers_.add(pattern, std::move(handler));
     return *this;
 }
 
@@ -6660,11 +7716,17 @@ inline bool Server::remove_mount_point(const std::string &mount_point) {
 
 inline Server &Server::set_file_extension_and_mimetype_mapping(const std::string &ext, const std::string &mime) {
     file_extension_and_mimetype_map_[ext] = mime;
+    if (file_cache_) {
+        file_cache_->clear();
+    }
     return *this;
 }
 
 inline Server &Server::set_default_file_mimetype(const std::string &mime) {
     default_file_mimetype_ = mime;
+    if (file_cache_) {
+        file_cache_->clear();
+    }
     return *this;
 }
 
@@ -6673,6 +7735,29 @@ inline Server &Server::set_file_request_handler(Handler handler) {
     return *this;
 }
 
+inline Server &Server::set_file_cache(size_t max_bytes, time_t revalidate_msec) {
+    if (max_bytes > 0) {
+        file_cache_ = detail::make_unique<detail::FileCache>(max_bytes, revalidate_msec);
+    } else {
+        file_cache_.reset();
+    }
+    return *this;
+}
+
+inline Server &Server::set_precompressed_files(bool on) {
+    precompressed_files_ = on;
+    return *this;
+}
+
+inline Server &Server::set_compression_cache(size_t max_bytes) {
+    if (max_bytes > 0) {
+        compression_cache_ = detail::make_unique<detail::CompressionCache>(max_bytes);
+    } else {
+        compression_cache_.reset();
+    }
+    return *this;
+}
+
 inline Server &Server::set_error_handler_core(HandlerWithResponse handler, std::true_type) {
     error_handler_ = std::move(handler);
     return *this;
@@ -6756,6 +7841,22 @@ inline Server &Server::set_keep_alive_timeout(time_t sec) {
     return *this;
 }
 
+inline Server &Server::set_event_loop(bool on) {
+    event_loop_ = on;
+    return *this;
+}
+
+inline Server &Server::set_acceptor_count(size_t count, bool pin_to_cores) {
+    acceptor_count_ = count > 0 ? count : 1;
+    pin_acceptors_ = pin_to_cores;
+    return *this;
+}
+
+inline Server &Server::set_listen_backlog(int backlog) {
+    listen_backlog_ = backlog;
+    return *this;
+}
+
 inline Server &Server::set_read_timeout(time_t sec, time_t usec) {
     read_timeout_sec_ = sec;
     read_timeout_usec_ = usec;
@@ -6814,6 +7915,11 @@ inline void Server::stop() {
         std::atomic<socket_t> sock(svr_sock_.exchange(INVALID_SOCKET));
         detail::shutdown_socket(sock);
         detail::close_socket(sock);
+        // Wakes up the other acceptors, their sockets are closed on the next bind
+        for (auto reuse_port_sock : reuse_port_socks_) {
+            detail::shutdown_socket(reuse_port_sock);
+        }
+        stop_event_.notify();
     }
     is_decommissioned = false;
 }
@@ -6981,6 +8087,17 @@ inline bool Server::write_content_with_provider(
     auto is_shutting_down = [this]() { return this->svr_sock_ == INVALID_SOCKET; };
 
     if (res.content_length_ > 0) {
+        if (res.content_file_ && req.ranges.size() <= 1) {
+            auto offset_and_length = req.ranges.empty()
+                                         ? std::pair<size_t, size_t>(0, res.content_length_)
+                                         : detail::get_range_offset_and_length(req.ranges[0], res.content_length_);
+            auto sent = detail::send_file_content(strm, res.content_file_->fd(), offset_and_length.first,
+                                                  offset_and_length.second, is_shutting_down);
+            if (sent > 0) {
+                return sent == offset_and_length.second || is_shutting_down();
+            }
+        }
+
         if (req.ranges.empty()) {
             return detail::write_content(strm, res.content_provider_, 0, res.content_length_, is_shutting_down);
         } else if (req.ranges.size() == 1) {
@@ -7138,54 +8255,133 @@ inline bool Server::handle_file_request(const Request &req, Response &res) {
                     path += "index.html";
                 }
 
-                detail::FileStat stat(path);
+                auto is_dir = false;
+                auto file = find_file(path, path, is_dir);
 
-                if (stat.is_dir()) {
+                if (is_dir) {
                     res.set_redirect(sub_path + "/", StatusCode::MovedPermanently_301);
                     return true;
                 }
 
-                if (stat.is_file()) {
-                    for (const auto &kv : entry.headers) {
-                        res.set_header(kv.first, kv.second);
-                    }
+                if (!file) {
+                    continue;
+                }
 
-                    auto mm = std::make_shared<detail::mmap>(path.c_str());
-                    if (!mm->is_open()) {
-                        return false;
-                    }
+                for (const auto &kv : entry.headers) {
+                    res.set_header(kv.first, kv.second);
+                }
 
-                    res.set_content_provider(
-                        mm->size(),
-                        detail::find_content_type(path, file_extension_and_mimetype_map_, default_file_mimetype_),
-                        [mm](size_t offset, size_t length, DataSink &sink) -> bool {
-                            sink.write(mm->data() + offset, length);
-                            return true;
-                        });
+                if (precompressed_files_ && detail::can_compress_content_type(file->content_type)) {
+                    static const std::pair<const char *, const char *> siblings[] = {
+                        {".br", "br"}, {".zst", "zstd"}, {".gz", "gzip"}};
+
+                    const auto &accept_encoding = req.get_header_value("Accept-Encoding");
+                    for (const auto &sibling : siblings) {
+                        if (detail::accepts_encoding(accept_encoding, sibling.second)) {
+                            auto sibling_is_dir = false;
+                            auto compressed = find_file(path + sibling.first, path, sibling_is_dir);
+                            if (compressed) {
+                                file = std::move(compressed);
+                                res.set_header("Content-Encoding", sibling.second);
+                                break;
+                            }
+                        }
+                    }
+                    res.set_header("Vary", "Accept-Encoding");
+                }
 
-                    if (req.method != "HEAD" && file_request_handler_) {
-                        file_request_handler_(req, res);
+                if (!file->etag.empty()) {
+                    res.set_header("ETag", file->etag);
+                    res.set_header("Last-Modified", file->last_modified);
+
+                    // If-Modified-Since is only compared for an exact match with
+                    // Last-Modified, which is what caches send back
+                    auto not_modified =
+                        req.has_header("If-None-Match")
+                            ? detail::etag_matches(req.get_header_value("If-None-Match"), file->etag)
+                            : req.get_header_value("If-Modified-Since") == file->last_modified;
+                    if (not_modified) {
+                        res.status = StatusCode::NotModified_304;
+                        res.set_header("Content-Length", std::to_string(file->file->size()));
+                        return true;
                     }
+                }
 
-                    return true;
+                auto mm = file->file;
+                res.set_content_provider(mm->size(), file->content_type,
+                                         [mm](size_t offset, size_t length, DataSink &sink) -> bool {
+                                             sink.write(mm->data() + offset, length);
+                                             return true;
+                                         });
+                res.content_file_ = mm;
+
+                if (req.method != "HEAD" && file_request_handler_) {
+                    file_request_handler_(req, res);
                 }
+
+                return true;
             }
         }
     }
     return false;
 }
 
+inline std::shared_ptr<const detail::FileCache::Entry> Server::find_file(const std::string &path,
+                                                                         const std::string &content_type_path,
+                                                                         bool &is_dir) {
+    // Siblings take the content type of another path, keep them apart from direct requests
+    auto key = path;
+    if (content_type_path != path) {
+        key += '\0';
+        key += content_type_path;
+    }
+
+    if (file_cache_) {
+        auto cached = file_cache_->find(key);
+        if (cached) {
+            return cached;
+        }
+    }
+
+    detail::FileStat stat(path);
+    is_dir = stat.is_dir();
+    if (!stat.is_file()) {
+        return nullptr;
+    }
+
+    if (file_cache_) {
+        auto cached = file_cache_->find(key, stat);
+        if (cached) {
+            return cached;
+        }
+    }
+
+    auto mm = std::make_shared<detail::mmap>(path.c_str());
+    if (!mm->is_open()) {
+        return nullptr;
+    }
+
+    auto content_type =
+        detail::find_content_type(content_type_path, file_extension_and_mimetype_map_, default_file_mimetype_);
+    if (file_cache_) {
+        return file_cache_->insert(key, stat, std::move(mm), std::move(content_type));
+    }
+    return std::make_shared<detail::FileCache::Entry>(
+        detail::FileCache::Entry{std::move(mm), std::move(content_type), {}, {}});
+}
+
 inline socket_t Server::create_server_socket(const std::string &host,
                                              int port,
                                              int socket_flags,
                                              SocketOptions socket_options) const {
+    const auto backlog = listen_backlog_;
     return detail::create_socket(host, std::string(), port, address_family_, socket_flags, tcp_nodelay_, ipv6_v6only_,
                                  std::move(socket_options),
-                                 [](socket_t sock, struct addrinfo &ai, bool & /*quit*/) -> bool {
+                                 [backlog](socket_t sock, struct addrinfo &ai, bool & /*quit*/) -> bool {
                                      if (::bind(sock, ai.ai_addr, static_cast<socklen_t>(ai.ai_addrlen))) {
                                          return false;
                                      }
-                                     if (::listen(sock, CPPHTTPLIB_LISTEN_BACKLOG)) {
+                                     if (::listen(sock, backlog)) {
                                          return false;
                                      }
                                      return true;
@@ -7201,7 +8397,21 @@ inline int Server::bind_internal(const std::string &host, int port, int socket_f
         return -1;
     }
 
-    svr_sock_ = create_server_socket(host, port, socket_flags, socket_options_);
+    close_reuse_port_sockets();
+
+    auto socket_options = socket_options_;
+#ifdef SO_REUSEPORT
+    if (acceptor_count_ > 1) {
+        socket_options = [options = socket_options_](socket_t sock) {
+            if (options) {
+                options(sock);
+            }
+            detail::set_socket_opt(sock, SOL_SOCKET, SO_REUSEPORT, 1);
+        };
+    }
+#endif
+
+    svr_sock_ = create_server_socket(host, port, socket_flags, socket_options);
     if (svr_sock_ == INVALID_SOCKET) {
         return -1;
     }
@@ -7213,15 +8423,34 @@ inline int Server::bind_internal(const std::string &host, int port, int socket_f
             return -1;
         }
         if (addr.ss_family == AF_INET) {
-            return ntohs(reinterpret_cast<struct sockaddr_in *>(&addr)->sin_port);
+            port = ntohs(reinterpret_cast<struct sockaddr_in *>(&addr)->sin_port);
         } else if (addr.ss_family == AF_INET6) {
-            return ntohs(reinterpret_cast<struct sockaddr_in6 *>(&addr)->sin6_port);
+            port = ntohs(reinterpret_cast<struct sockaddr_in6 *>(&addr)->sin6_port);
         } else {
             return -1;
         }
-    } else {
-        return port;
     }
+
+#ifdef SO_REUSEPORT
+    for (size_t i = 1; i < acceptor_count_; i++) {
+        auto sock = create_server_socket(host, port, socket_flags, socket_options);
+        if (sock == INVALID_SOCKET) {
+            close_reuse_port_sockets();
+            detail::close_socket(svr_sock_.exchange(INVALID_SOCKET));
+            return -1;
+        }
+        reuse_port_socks_.push_back(sock);
+    }
+#endif
+
+    return port;
+}
+
+inline void Server::close_reuse_port_sockets() {
+    for (auto sock : reuse_port_socks_) {
+        detail::close_socket(sock);
+    }
+    reuse_port_socks_.clear();
 }
 
 inline bool Server::listen_internal() {
@@ -7230,67 +8459,363 @@ inline bool Server::listen_internal() {
     }
 
     auto ret = true;
+    stop_event_.reset();
     is_running_ = true;
     auto se = detail::scope_exit([&]() { is_running_ = false; });
 
     {
-        std::unique_ptr<TaskQueue> task_queue(new_task_queue());
+        std::vector<socket_t> listen_socks{svr_sock_};
+        listen_socks.insert(listen_socks.end(), reuse_port_socks_.begin(), reuse_port_socks_.end());
 
-        while (svr_sock_ != INVALID_SOCKET) {
-#ifndef _WIN32
-            if (idle_interval_sec_ > 0 || idle_interval_usec_ > 0) {
-#endif
-                auto val = detail::select_read(svr_sock_, idle_interval_sec_, idle_interval_usec_);
-                if (val == 0) {  // Timeout
-                    task_queue->on_idle();
-                    continue;
+        std::atomic<bool> acceptors_ok{true};
+        auto serve = [&](size_t i) {
+            auto listen_sock = listen_socks[i];
+            if (serve_socket(listen_sock)) {
+                return;
+            }
+            acceptors_ok = false;
+
+            // Take the other acceptors down as stop() does. A failed primary
+            // acceptor has closed its socket already.
+            auto sock = svr_sock_.exchange(INVALID_SOCKET);
+            if (sock != INVALID_SOCKET && sock != listen_sock) {
+                detail::shutdown_socket(sock);
+                detail::close_socket(sock);
+            }
+            for (auto reuse_port_sock : reuse_port_socks_) {
+                if (reuse_port_sock != listen_sock) {
+                    detail::shutdown_socket(reuse_port_sock);
                 }
+            }
+            stop_event_.notify();
+        };
+
+        // Pinning applies to spawned threads only, the caller keeps its affinity
+        std::vector<std::thread> acceptors;
+        for (size_t i = pin_acceptors_ ? 0 : 1; i < listen_socks.size(); i++) {
+            acceptors.emplace_back([&, i]() {
+                if (pin_acceptors_) {
+                    detail::pin_thread_to_core(i);
+                }
+                serve(i);
+            });
+        }
+        if (!pin_acceptors_) {
+            serve(0);
+        }
+
+        for (auto &t : acceptors) {
+            t.join();
+        }
+        ret = acceptors_ok;
+    }
+
+    is_decommissioned = !ret;
+    return ret;
+}
+
+inline bool Server::serve_socket(socket_t listen_sock) {
+    std::unique_ptr<TaskQueue> task_queue(new_task_queue());
+
+#ifdef __linux__
+    if (event_loop_ && supports_event_loop()) {
+        // Shuts the task queue down itself, it owns connections the workers still use
+        return run_event_loop(listen_sock, *task_queue);
+    }
+#endif
+
+    auto ret = true;
+    while (svr_sock_ != INVALID_SOCKET) {
 #ifndef _WIN32
+        if (idle_interval_sec_ > 0 || idle_interval_usec_ > 0) {
+#endif
+            auto val = detail::select_read(listen_sock, idle_interval_sec_, idle_interval_usec_);
+            if (val == 0) {  // Timeout
+                task_queue->on_idle();
+                continue;
             }
+#ifndef _WIN32
+        }
 #endif
 
 #if defined _WIN32
-            // sockets connected via WASAccept inherit flags NO_HANDLE_INHERIT,
-            // OVERLAPPED
-            socket_t sock = WSAAccept(svr_sock_, nullptr, nullptr, nullptr, 0);
+        // sockets connected via WASAccept inherit flags NO_HANDLE_INHERIT,
+        // OVERLAPPED
+        socket_t sock = WSAAccept(listen_sock, nullptr, nullptr, nullptr, 0);
 #elif defined SOCK_CLOEXEC
-            socket_t sock = accept4(svr_sock_, nullptr, nullptr, SOCK_CLOEXEC);
+        socket_t sock = accept4(listen_sock, nullptr, nullptr, SOCK_CLOEXEC);
 #else
-            socket_t sock = accept(svr_sock_, nullptr, nullptr);
+        socket_t sock = accept(listen_sock, nullptr, nullptr);
 #endif
 
+        if (sock == INVALID_SOCKET) {
+            if (errno == EMFILE) {
+                // The per-process limit of open file descriptors has been reached.
+                // Try to accept new connections after a short sleep.
+                std::this_thread::sleep_for(std::chrono::microseconds{1});
+                continue;
+            } else if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            if (svr_sock_ != INVALID_SOCKET) {
+                if (listen_sock == svr_sock_) {
+                    detail::close_socket(svr_sock_);
+                }
+                ret = false;
+            } else {
+                ;  // The server socket was closed by user.
+            }
+            break;
+        }
+
+        detail::set_socket_opt_time(sock, SOL_SOCKET, SO_RCVTIMEO, read_timeout_sec_, read_timeout_usec_);
+        detail::set_socket_opt_time(sock, SOL_SOCKET, SO_SNDTIMEO, write_timeout_sec_, write_timeout_usec_);
+
+        if (!task_queue->enqueue([this, sock]() { process_and_close_socket(sock); })) {
+            detail::shutdown_socket(sock);
+            detail::close_socket(sock);
+        }
+    }
+
+    task_queue->shutdown();
+    return ret;
+}
+
+inline bool Server::run_event_loop(socket_t listen_sock, TaskQueue &task_queue) {
+#ifdef __linux__
+    using namespace std::chrono;
+
+    struct Connection {
+        socket_t sock;
+        size_t remaining;
+        steady_clock::time_point deadline;
+        std::string remote_addr;
+        int remote_port = 0;
+        std::string local_addr;
+        int local_port = 0;
+    };
+
+    auto ret = true;
+    const auto epfd = epoll_create1(EPOLL_CLOEXEC);
+    detail::WakeupEvent done_event;
+
+    auto add_fd = [&](socket_t fd) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        return epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) == 0;
+    };
+
+    if (listen_sock == INVALID_SOCKET || epfd < 0 || !done_event.is_valid() || !stop_event_.is_valid() ||
+        !add_fd(listen_sock) || !add_fd(stop_event_.fd()) || !add_fd(done_event.fd())) {
+        if (epfd >= 0) {
+            close(epfd);
+        }
+        task_queue.shutdown();
+        return false;
+    }
+    detail::set_nonblocking(listen_sock, true);
+
+    // Only this thread touches connections and deadlines, workers hand
+    // connections back through done_list and wake the loop with done_event
+    std::unordered_map<socket_t, Connection> connections;
+    std::set<std::pair<steady_clock::time_point, socket_t>> deadlines;
+    std::mutex done_mutex;
+    std::vector<std::pair<socket_t, bool>> done_list;
+
+    // Out of descriptors the level triggered listener would report the backlog
+    // forever, it leaves the epoll set until a connection closes or the backoff ends
+    const auto accept_backoff = milliseconds{10};
+    auto accept_paused = false;
+    steady_clock::time_point accept_resume;
+
+    auto drop = [&](socket_t sock) {
+        // Closing also removes the socket from the epoll set
+        detail::shutdown_socket(sock);
+        detail::close_socket(sock);
+        connections.erase(sock);
+        if (accept_paused) {
+            accept_resume = steady_clock::now();
+        }
+    };
+
+    // A connection waits for its first request as long as reading one may take,
+    // later ones as long as the keep-alive timeout, but at least one check
+    // interval like keep_alive() in the blocking mode
+    const auto first_request_timeout = (std::max)(duration_cast<microseconds>(seconds{keep_alive_timeout_sec_}),
+                                                  seconds{read_timeout_sec_} + microseconds{read_timeout_usec_});
+    const auto next_request_timeout = (std::max)(duration_cast<microseconds>(seconds{keep_alive_timeout_sec_}),
+                                                 microseconds{CPPHTTPLIB_KEEPALIVE_TIMEOUT_CHECK_INTERVAL_USECOND});
+
+    auto park = [&](Connection &conn, int op) {
+        // One shot, a connection is never dispatched twice while a worker owns it
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLET | EPOLLONESHOT;
+        ev.data.fd = conn.sock;
+        if (epoll_ctl(epfd, op, conn.sock, &ev) != 0) {
+            return false;
+        }
+        conn.deadline = steady_clock::now() + (op == EPOLL_CTL_ADD ? first_request_timeout : next_request_timeout);
+        deadlines.emplace(conn.deadline, conn.sock);
+        return true;
+    };
+
+    auto dispatch = [&](Connection &conn) {
+        deadlines.erase({conn.deadline, conn.sock});
+        auto queued = task_queue.enqueue([this, &conn, &done_mutex, &done_list, &done_event]() {
+            detail::SocketStream strm(conn.sock, read_timeout_sec_, read_timeout_usec_, write_timeout_sec_,
+                                      write_timeout_usec_);
+            auto close_connection = conn.remaining == 1;
+            auto connection_closed = false;
+            auto processed = process_request(strm, conn.remote_addr, conn.remote_port, conn.local_addr,
+                                             conn.local_port, close_connection, connection_closed, nullptr);
+            auto keep = processed && !connection_closed && --conn.remaining > 0;
+            {
+                std::lock_guard<std::mutex> guard(done_mutex);
+                done_list.emplace_back(conn.sock, keep);
+            }
+            done_event.notify();
+        });
+        if (!queued) {
+            drop(conn.sock);
+        }
+    };
+
+    auto accept_all = [&]() {
+        while (true) {
+            socket_t sock = accept4(listen_sock, nullptr, nullptr, SOCK_CLOEXEC);
             if (sock == INVALID_SOCKET) {
-                if (errno == EMFILE) {
-                    // The per-process limit of open file descriptors has been reached.
-                    // Try to accept new connections after a short sleep.
-                    std::this_thread::sleep_for(std::chrono::microseconds{1});
-                    continue;
-                } else if (errno == EINTR || errno == EAGAIN) {
+                if (errno == EINTR) {
                     continue;
                 }
-                if (svr_sock_ != INVALID_SOCKET) {
-                    detail::close_socket(svr_sock_);
-                    ret = false;
-                } else {
-                    ;  // The server socket was closed by user.
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    return true;
                 }
-                break;
+                if (errno == EMFILE || errno == ENFILE) {
+                    if (epoll_ctl(epfd, EPOLL_CTL_DEL, listen_sock, nullptr) != 0) {
+                        return false;
+                    }
+                    accept_paused = true;
+                    accept_resume = steady_clock::now() + accept_backoff;
+                    return true;
+                }
+                return false;
             }
 
             detail::set_socket_opt_time(sock, SOL_SOCKET, SO_RCVTIMEO, read_timeout_sec_, read_timeout_usec_);
             detail::set_socket_opt_time(sock, SOL_SOCKET, SO_SNDTIMEO, write_timeout_sec_, write_timeout_usec_);
 
-            if (!task_queue->enqueue([this, sock]() { process_and_close_socket(sock); })) {
-                detail::shutdown_socket(sock);
-                detail::close_socket(sock);
+            auto &conn = connections[sock];
+            conn.sock = sock;
+            conn.remaining = keep_alive_max_count_;
+            detail::get_remote_ip_and_port(sock, conn.remote_addr, conn.remote_port);
+            detail::get_local_ip_and_port(sock, conn.local_addr, conn.local_port);
+            if (!park(conn, EPOLL_CTL_ADD)) {
+                drop(sock);
+            }
+        }
+    };
+
+    const auto has_idle_interval = idle_interval_sec_ > 0 || idle_interval_usec_ > 0;
+    std::vector<epoll_event> events(CPPHTTPLIB_EVENT_LOOP_MAX_EVENTS);
+    std::vector<std::pair<socket_t, bool>> finished;
+
+    while (svr_sock_ != INVALID_SOCKET) {
+        auto timeout = -1;
+        if (has_idle_interval) {
+            timeout = static_cast<int>(idle_interval_sec_ * 1000 + idle_interval_usec_ / 1000);
+        }
+        for (auto wake : {deadlines.empty() ? steady_clock::time_point::max() : deadlines.begin()->first,
+                          accept_paused ? accept_resume : steady_clock::time_point::max()}) {
+            if (wake == steady_clock::time_point::max()) {
+                continue;
+            }
+            auto until = duration_cast<milliseconds>(wake - steady_clock::now()).count() + 1;
+            auto wake_timeout = static_cast<int>((std::max<decltype(until)>)(until, 0));
+            timeout = timeout < 0 ? wake_timeout : (std::min)(timeout, wake_timeout);
+        }
+
+        auto n = epoll_wait(epfd, events.data(), static_cast<int>(events.size()), timeout);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
             }
+            ret = false;
+            break;
+        }
+        if (n == 0 && has_idle_interval) {
+            task_queue.on_idle();
+        }
+
+        for (int i = 0; i < n; i++) {
+            auto fd = events[i].data.fd;
+            if (fd == stop_event_.fd()) {
+                continue;  // The loop condition sees the closed server socket
+            } else if (fd == done_event.fd()) {
+                done_event.reset();
+            } else if (fd == listen_sock) {
+                if (!accept_all() && svr_sock_ != INVALID_SOCKET) {
+                    if (listen_sock == svr_sock_) {
+                        detail::close_socket(svr_sock_);
+                    }
+                    ret = false;
+                }
+            } else {
+                auto it = connections.find(fd);
+                if (it != connections.end()) {
+                    dispatch(it->second);
+                }
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(done_mutex);
+            finished.swap(done_list);
         }
+        for (const auto &item : finished) {
+            auto it = connections.find(item.first);
+            if (it == connections.end()) {
+                continue;
+            }
+            if (!item.second || !park(it->second, EPOLL_CTL_MOD)) {
+                drop(item.first);
+            }
+        }
+        finished.clear();
 
-        task_queue->shutdown();
+        const auto now = steady_clock::now();
+        while (!deadlines.empty() && deadlines.begin()->first <= now) {
+            auto sock = deadlines.begin()->second;
+            deadlines.erase(deadlines.begin());
+            drop(sock);
+        }
+
+        if (accept_paused && accept_resume <= steady_clock::now()) {
+            if (add_fd(listen_sock)) {
+                accept_paused = false;
+            } else {
+                accept_resume = steady_clock::now() + accept_backoff;
+            }
+        }
+
+        if (!ret) {
+            break;
+        }
     }
 
-    is_decommissioned = !ret;
+    // Workers may still run requests on their connections
+    task_queue.shutdown();
+    for (const auto &kv : connections) {
+        detail::shutdown_socket(kv.first);
+        detail::close_socket(kv.first);
+    }
+    close(epfd);
     return ret;
+#else
+    (void)listen_sock;
+    task_queue.shutdown();
+    return false;
+#endif
 }
 
 inline bool Server::routing(Request &req, Response &res, Stream &strm) {
@@ -7364,19 +8889,19 @@ inline bool Server::routing(Request &req, Response &res, Stream &strm) {
 }
 
 inline bool Server::dispatch_request(Request &req, Response &res, const Handlers &handlers) const {
-    for (const auto &x : handlers) {
-        const auto &matcher = x.first;
-        const auto &handler = x.second;
+    auto route = handlers.tree.find(req.path, [&](size_t i) { return handlers.handlers[i].first->match(req); });
+    if (route == detail::RouteTree::npos) {
+        return false;
+    }
 
-        if (matcher->match(req)) {
-            req.matched_route = matcher->pattern();
-            if (!pre_request_handler_ || pre_request_handler_(req, res) != HandlerResponse::Handled) {
-                handler(req, res);
-            }
-            return true;
-        }
+    const auto &matcher = handlers.handlers[route].first;
+    const auto &handler = handlers.handlers[route].second;
+
+    req.matched_route = matcher->pattern();
+    if (!pre_request_handler_ || pre_request_handler_(req, res) != HandlerResponse::Handled) {
+        handler(req, res);
     }
-    return false;
+    return true;
 }
 
 inline void Server::apply_ranges(const Request &req,
@@ -7469,11 +8994,17 @@ inline void Server::apply_ranges(const Request &req,
 
             if (compressor) {
                 std::string compressed;
-                if (compressor->compress(res.body.data(), res.body.size(), true,
-                                         [&](const char *data, size_t data_len) {
-                                             compressed.append(data, data_len);
-                                             return true;
-                                         })) {
+                if (compression_cache_ && compression_cache_->find(type, res.body, compressed)) {
+                    res.body.swap(compressed);
+                    res.set_header("Content-Encoding", content_encoding);
+                } else if (compressor->compress(res.body.data(), res.body.size(), true,
+                                                [&](const char *data, size_t data_len) {
+                                                    compressed.append(data, data_len);
+                                                    return true;
+                                                })) {
+                    if (compression_cache_) {
+                        compression_cache_->insert(type, res.body, compressed);
+                    }
                     res.body.swap(compressed);
                     res.set_header("Content-Encoding", content_encoding);
                 }
@@ -7489,19 +9020,19 @@ inline bool Server::dispatch_request_for_content_reader(Request &req,
                                                         Response &res,
                                                         ContentReader content_reader,
                                                         const HandlersForContentReader &handlers) const {
-    for (const auto &x : handlers) {
-        const auto &matcher = x.first;
-        const auto &handler = x.second;
+    auto route = handlers.tree.find(req.path, [&](size_t i) { return handlers.handlers[i].first->match(req); });
+    if (route == detail::RouteTree::npos) {
+        return false;
+    }
 
-        if (matcher->match(req)) {
-            req.matched_route = matcher->pattern();
-            if (!pre_request_handler_ || pre_request_handler_(req, res) != HandlerResponse::Handled) {
-                handler(req, res, content_reader);
-            }
-            return true;
-        }
+    const auto &matcher = handlers.handlers[route].first;
+    const auto &handler = handlers.handlers[route].second;
+
+    req.matched_route = matcher->pattern();
+    if (!pre_request_handler_ || pre_request_handler_(req, res) != HandlerResponse::Handled) {
+        handler(req, res, content_reader);
     }
-    return false;
+    return true;
 }
 
 inline bool Server::process_request(Stream &strm,
@@ -7662,6 +9193,7 @@ inline bool Server::process_request(Stream &strm,
                                          sink.write(mm->data() + offset, length);
                                          return true;
                                      });
+            res.content_file_ = mm;
         }
 
         if (detail::range_error(req, res)) {
@@ -7694,8 +9226,9 @@ inline bool Server::process_and_close_socket(socket_t sock) {
     detail::get_local_ip_and_port(sock, local_addr, local_port);
 
     auto ret = detail::process_server_socket(
-        svr_sock_, sock, keep_alive_max_count_, keep_alive_timeout_sec_, read_timeout_sec_, read_timeout_usec_,
-        write_timeout_sec_, write_timeout_usec_, [&](Stream &strm, bool close_connection, bool &connection_closed) {
+        svr_sock_, stop_event_.fd(), sock, keep_alive_max_count_, keep_alive_timeout_sec_, read_timeout_sec_,
+        read_timeout_usec_, write_timeout_sec_, write_timeout_usec_,
+        [&](Stream &strm, bool close_connection, bool &connection_closed) {
             return process_request(strm, remote_addr, remote_port, local_addr, local_port, close_connection,
                                    connection_closed, nullptr);
         });
@@ -9439,6 +10972,7 @@ bool ssl_connect_or_accept_nonblocking(
 
 template <typename T>
 inline bool process_server_socket_ssl(const std::atomic<socket_t> &svr_sock,
+                                      socket_t stop_fd,
                                       SSL *ssl,
                                       socket_t sock,
                                       size_t keep_alive_max_count,
@@ -9448,7 +10982,7 @@ inline bool process_server_socket_ssl(const std::atomic<socket_t> &svr_sock,
                                       time_t write_timeout_sec,
                                       time_t write_timeout_usec,
                                       T callback) {
-    return process_server_socket_core(svr_sock, sock, keep_alive_max_count, keep_alive_timeout_sec,
+    return process_server_socket_core(svr_sock, stop_fd, sock, keep_alive_max_count, keep_alive_timeout_sec,
                                       [&](bool close_connection, bool &connection_closed) {
                                           SSLSocketStream strm(sock, ssl, read_timeout_sec, read_timeout_usec,
                                                                write_timeout_sec, write_timeout_usec);
@@ -9696,8 +11230,9 @@ inline bool SSLServer::process_and_close_socket(socket_t sock) {
         detail::get_local_ip_and_port(sock, local_addr, local_port);
 
         ret = detail::process_server_socket_ssl(
-            svr_sock_, ssl, sock, keep_alive_max_count_, keep_alive_timeout_sec_, read_timeout_sec_, read_timeout_usec_,
-            write_timeout_sec_, write_timeout_usec_, [&](Stream &strm, bool close_connection, bool &connection_closed) {
+            svr_sock_, stop_event_.fd(), ssl, sock, keep_alive_max_count_, keep_alive_timeout_sec_, read_timeout_sec_,
+            read_timeout_usec_, write_timeout_sec_, write_timeout_usec_,
+            [&](Stream &strm, bool close_connection, bool &connection_closed) {
                 return process_request(strm, remote_addr, remote_port, local_addr, local_port, close_connection,
                                        connection_closed, [&](Request &req) { req.ssl = ssl; });
             });
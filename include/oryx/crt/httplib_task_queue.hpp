@@ -0,0 +1,99 @@
+#pragma once
+
+#include <mutex>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <condition_variable>
+
+#include "httplib.hpp"
+#include "thread_pool.hpp"
+
+namespace oryx::crt {
+
+/**
+ * @brief httplib::TaskQueue running connections on an existing BS::thread_pool, so HTTP and background work share one
+ * sized pool instead of the server spawning its own threads
+ *
+ * Install it through Server::new_task_queue, the server owns the queue but never the pool:
+ *
+ *     svr.new_task_queue = [&pool] { return new PooledTaskQueue(pool); };
+ *
+ * A connection occupies a pool thread for as long as it is kept alive, with the default server mode a handful of idle
+ * clients can starve background tasks. Prefer Server::set_event_loop(true), which only hands a connection to the pool
+ * while a request is ready. Handlers must not wait on tasks of the same pool.
+ *
+ * With tp::priority enabled connections are queued with the given priority, otherwise it is ignored.
+ */
+template <BS::opt_t Opts>
+class PooledTaskQueue final : public httplib::TaskQueue {
+public:
+    /**
+     * @param max_queued Connections queued or running at once, beyond that the server rejects them, 0 is unlimited
+     */
+    explicit PooledTaskQueue(BS::thread_pool<Opts>& pool, size_t max_queued = 0, BS::priority_t priority = 0)
+        : pool_(pool),
+          max_queued_(max_queued),
+          priority_(priority) {}
+
+    PooledTaskQueue(const PooledTaskQueue&) = delete;
+    auto operator=(const PooledTaskQueue&) -> PooledTaskQueue& = delete;
+
+    ~PooledTaskQueue() override { shutdown(); }
+
+    auto enqueue(std::function<void()> fn) -> bool override {
+        {
+            std::lock_guard lock{mtx_};
+            if (stopped_ || (max_queued_ > 0 && pending_ >= max_queued_)) {
+                return false;
+            }
+            ++pending_;
+        }
+
+        pool_.detach_task(
+                [this, fn = std::move(fn)] {
+                    // Release the slot even if fn throws, otherwise shutdown() waits forever
+                    struct Done {
+                        PooledTaskQueue* queue;
+                        ~Done() { queue->Release(); }
+                    } done{this};
+                    fn();
+                },
+                priority_);
+        return true;
+    }
+
+    /**
+     * @brief Wait for the connections handed to the pool, the pool itself keeps running
+     */
+    void shutdown() override {
+        std::unique_lock lock{mtx_};
+        stopped_ = true;
+        idle_.wait(lock, [this] { return pending_ == 0; });
+    }
+
+    [[nodiscard]] auto Pending() const -> size_t {
+        std::lock_guard lock{mtx_};
+        return pending_;
+    }
+
+private:
+    void Release() {
+        // Notify under the lock, shutdown() may destroy the queue as soon as it can reacquire it
+        std::lock_guard lock{mtx_};
+        if (--pending_ == 0) {
+            idle_.notify_all();
+        }
+    }
+
+    BS::thread_pool<Opts>& pool_;
+    const size_t max_queued_;
+    const BS::priority_t priority_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable idle_;
+    size_t pending_{};
+    bool stopped_{};
+};
+
+}  // namespace oryx::crt
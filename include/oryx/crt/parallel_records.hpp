@@ -0,0 +1,109 @@
+#pragma once
+
+#include <mutex>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+#include "thread_pool.hpp"
+
+namespace oryx::crt {
+
+struct ParallelRecordsConfig {
+    char delim{'\n'};
+    // Number of chunks the data is split into, 0 uses the thread count of the pool
+    size_t num_chunks{};
+    // Combine chunk results in file order, otherwise in completion order which needs a commutative reduce
+    bool ordered{true};
+};
+
+namespace detail {
+
+// A record belongs to the chunk its first byte lies in
+inline auto AlignToRecordStart(std::string_view data, size_t pos, char delim) -> size_t {
+    if (pos == 0 || pos >= data.size()) {
+        return pos;
+    }
+
+    auto delim_pos = data.find(delim, pos - 1);
+    return delim_pos == std::string_view::npos ? data.size() : delim_pos + 1;
+}
+
+template <class T, class RecordFn>
+auto ProcessChunk(std::string_view chunk, char delim, const T& identity, RecordFn& on_record) -> T {
+    T acc = identity;
+    while (!chunk.empty()) {
+        auto delim_pos = chunk.find(delim);
+        if (delim_pos == std::string_view::npos) {
+            std::invoke(on_record, acc, chunk);
+            break;
+        }
+        std::invoke(on_record, acc, chunk.substr(0, delim_pos));
+        chunk.remove_prefix(delim_pos + 1);
+    }
+    return acc;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Map reduce over the delimiter separated records of data, e.g. a MappedFile, on a thread pool
+ *
+ * Data is split into chunks aligned on record boundaries. Each chunk starts from a copy of identity and calls
+ * on_record(T& acc, std::string_view record) for every record, chunk results are combined with reduce(T, T) -> T
+ * starting from identity. Records follow the RecordReader rules: a trailing delimiter does not produce an empty record.
+ *
+ * on_record is called concurrently from pool threads, reduce is serialized.
+ */
+template <class T, BS::opt_t Opts, class RecordFn, class ReduceFn>
+    requires std::invocable<RecordFn&, T&, std::string_view> && std::is_invocable_r_v<T, ReduceFn&, T, T>
+auto ParallelReduceRecords(BS::thread_pool<Opts>& pool,
+                           std::string_view data,
+                           T identity,
+                           RecordFn&& on_record,
+                           ReduceFn&& reduce,
+                           ParallelRecordsConfig config = {}) -> T {
+    if (data.empty()) {
+        return identity;
+    }
+
+    auto num_chunks = config.num_chunks > 0 ? config.num_chunks : pool.get_thread_count();
+    auto process = [&](size_t begin, size_t end) {
+        begin = detail::AlignToRecordStart(data, begin, config.delim);
+        end = detail::AlignToRecordStart(data, end, config.delim);
+        if (begin >= end) {
+            return identity;
+        }
+        return detail::ProcessChunk(data.substr(begin, end - begin), config.delim, identity, on_record);
+    };
+
+    if (config.ordered) {
+        auto futures = pool.submit_blocks(size_t{0}, data.size(), process, num_chunks);
+        // get() rethrows on the first failed block, the others still reference this frame
+        futures.wait();
+        auto chunk_results = futures.get();
+        T result = std::move(identity);
+        for (auto& chunk_result : chunk_results) {
+            result = std::invoke(reduce, std::move(result), std::move(chunk_result));
+        }
+        return result;
+    }
+
+    std::mutex mtx;
+    T result = identity;
+    auto futures = pool.submit_blocks(
+            size_t{0}, data.size(),
+            [&](size_t begin, size_t end) {
+                auto chunk_result = process(begin, end);
+                std::lock_guard lock{mtx};
+                result = std::invoke(reduce, std::move(result), std::move(chunk_result));
+            },
+            num_chunks);
+    futures.wait();
+    futures.get();
+    return result;
+}
+
+}  // namespace oryx::crt
\ No newline at end of file
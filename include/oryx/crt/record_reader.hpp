@@ -0,0 +1,93 @@
+#pragma once
+
+#include <memory>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+#include "error.hpp"
+#include "unique_file_ptr.hpp"
+
+namespace oryx::crt {
+
+/**
+ * @brief Read only memory mapping of a whole file
+ *
+ * Mapping fails for anything that is not a regular file, e.g. pipes, and on platforms without mmap.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(FILE* file);
+
+    MappedFile(MappedFile&& other) noexcept;
+    auto operator=(MappedFile&& other) noexcept -> MappedFile&;
+
+    MappedFile(const MappedFile&) = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+    ~MappedFile();
+
+    static auto Open(std::string_view file_name) -> MappedFile;
+
+    /**
+     * @brief Hint the kernel that the mapping is read front to back, enables aggressive readahead
+     */
+    void AdviseSequential() const;
+
+    [[nodiscard]] auto View() const noexcept -> std::string_view { return {data_, size_}; }
+    [[nodiscard]] auto IsValid() const noexcept -> bool { return valid_; }
+
+private:
+    void Unmap() noexcept;
+
+    const char* data_{};
+    size_t size_{};
+    bool valid_{};
+};
+
+/**
+ * @brief Zero copy reader returning delimiter separated records of a file
+ *
+ * Regular files are memory mapped and records stay valid for the lifetime of the reader. Everything else is read
+ * through a large buffer and records are only valid until the next call to Next(). Delimiters are not part of the
+ * returned records, a trailing delimiter does not produce an empty last record.
+ *
+ * Reading starts at the current position of a seekable file, even if stdio already buffered past it. Pipes and other
+ * unseekable files are read through their descriptor and must not have been read through the FILE before.
+ */
+class RecordReader {
+public:
+    static constexpr size_t kDefaultBufferSize = 1 << 20;
+
+    explicit RecordReader(UniqueFilePtr file, char delim = '\n', size_t buffer_size = kDefaultBufferSize);
+
+    /**
+     * @brief Next record, std::nullopt at the end of the file or after a read error, see ReadError()
+     */
+    [[nodiscard]] auto Next() -> std::optional<std::string_view>;
+
+    [[nodiscard]] auto ReadError() const noexcept -> const std::optional<Error>& { return read_error_; }
+
+    [[nodiscard]] auto IsMapped() const noexcept -> bool { return mapped_.IsValid(); }
+
+private:
+    auto NextMapped() -> std::optional<std::string_view>;
+    auto NextBuffered() -> std::optional<std::string_view>;
+    void Fill();
+
+    UniqueFilePtr file_;
+    MappedFile mapped_;
+    std::string_view remaining_;
+    std::unique_ptr<char[]> buffer_;
+    size_t capacity_;
+    size_t begin_{};
+    size_t scanned_{};
+    size_t end_{};
+    std::optional<Error> read_error_;
+    char delim_;
+    bool eof_{};
+};
+
+}  // namespace oryx::crt
\ No newline at end of file
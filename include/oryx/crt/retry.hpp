@@ -1,53 +1,195 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <concepts>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <stop_token>
 #include <thread>
 #include <type_traits>
 #include <cstdint>
 
 namespace oryx::crt::retry {
 
+/**
+ * @brief Randomization applied to the exponential backoff, spreads out clients that failed at the same time
+ */
+enum class Jitter : uint8_t {
+    kNone,          // Plain exponential backoff
+    kFull,          // Uniform in [0, backoff]
+    kEqual,         // Half the backoff plus uniform in [0, backoff / 2]
+    kDecorrelated,  // Uniform in [start_backoff, 3 * previous wait], capped at max_backoff
+};
+
+/**
+ * @brief Lock free token bucket limiting retries to a fraction of all requests.
+ *
+ * Every retry loop deposits retry_ratio tokens, every retry withdraws one. Share a single instance between all
+ * callers talking to the same backend to cap the retry load they can generate.
+ */
+class RetryBudget {
+public:
+    explicit RetryBudget(double retry_ratio, uint32_t max_tokens = 10)
+        : deposit_(static_cast<int64_t>(retry_ratio * kScale)),
+          max_(static_cast<int64_t>(max_tokens) * kScale),
+          tokens_(max_) {}
+
+    void Deposit() noexcept {
+        auto tokens = tokens_.load(std::memory_order_relaxed);
+        while (tokens < max_ &&
+               !tokens_.compare_exchange_weak(tokens, std::min(tokens + deposit_, max_), std::memory_order_relaxed)) {
+        }
+    }
+
+    [[nodiscard]] auto TryWithdraw() noexcept -> bool {
+        auto tokens = tokens_.load(std::memory_order_relaxed);
+        while (tokens >= kScale) {
+            if (tokens_.compare_exchange_weak(tokens, tokens - kScale, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] auto Tokens() const noexcept -> double {
+        return static_cast<double>(tokens_.load(std::memory_order_relaxed)) / kScale;
+    }
+
+private:
+    static constexpr int64_t kScale = 1000;
+
+    const int64_t deposit_;
+    const int64_t max_;
+    std::atomic<int64_t> tokens_;
+};
+
 struct ExponentialConfig {
     using Duration = std::chrono::milliseconds;
 
     Duration start_backoff;
     Duration max_backoff;
     uint64_t max_retries;
+    Jitter jitter{Jitter::kNone};
+    RetryBudget *budget{};
 };
 
-template <std::invocable F, std::predicate Predicate>
-inline auto ExponentialBackoff(ExponentialConfig config, F &&retryable, Predicate &&predicate)
+namespace detail {
+
+// splitmix64, seeded once per thread. Not suitable for anything security related.
+inline auto ThreadLocalRandom() noexcept -> uint64_t {
+    thread_local uint64_t state = (static_cast<uint64_t>(std::random_device{}()) << 32) ^
+                                  reinterpret_cast<uintptr_t>(&state);
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Sequence of waits between attempts as described by an ExponentialConfig
+ */
+class Backoff {
+public:
+    using Duration = ExponentialConfig::Duration;
+
+    explicit Backoff(const ExponentialConfig &config)
+        : config_(config),
+          current_(config.start_backoff),
+          previous_(config.start_backoff) {}
+
+    auto Next() -> Duration {
+        auto current = current_;
+        current_ = current_ * 2 > config_.max_backoff ? config_.max_backoff : current_ * 2;
+
+        switch (config_.jitter) {
+            case Jitter::kNone:
+                return current;
+            case Jitter::kFull:
+                return Uniform(Duration::zero(), current);
+            case Jitter::kEqual:
+                return current / 2 + Uniform(Duration::zero(), current - current / 2);
+            case Jitter::kDecorrelated:
+                previous_ = std::min(config_.max_backoff,
+                                     Uniform(config_.start_backoff, std::max(config_.start_backoff, previous_ * 3)));
+                return previous_;
+        }
+        return current;
+    }
+
+private:
+    static auto Uniform(Duration low, Duration high) -> Duration {
+        auto range = static_cast<uint64_t>((high - low).count()) + 1;
+        return low + Duration(static_cast<Duration::rep>(detail::ThreadLocalRandom() % range));
+    }
+
+    ExponentialConfig config_;
+    Duration current_;
+    Duration previous_;
+};
+
+namespace detail {
+
+template <std::invocable F, std::predicate Predicate, std::invocable<ExponentialConfig::Duration> Sleep>
+inline auto ExponentialBackoffImpl(ExponentialConfig config, F &&retryable, Predicate &&predicate, Sleep &&sleep)
     -> std::invoke_result_t<F> {
     using Result = std::invoke_result_t<F>;
 
-    auto current_backoff = config.start_backoff;
+    Backoff backoff{config};
     uint64_t num_retries{};
     Result result;
 
-    while (!predicate() && num_retries < config.max_retries) {
+    if (config.budget) {
+        config.budget->Deposit();
+    }
+
+    while (num_retries < config.max_retries && !predicate()) {
         result = retryable();
-        if (result) {
+        if (result || ++num_retries >= config.max_retries || predicate()) {
             break;
         }
 
-        if (predicate()) return result;
-        std::this_thread::sleep_for(current_backoff);
-        current_backoff = current_backoff * 2 > config.max_backoff ? config.max_backoff : current_backoff * 2;
-        num_retries++;
+        if (config.budget && !config.budget->TryWithdraw()) {
+            break;
+        }
+        sleep(backoff.Next());
     }
     return result;
 }
 
+}  // namespace detail
+
+template <std::invocable F, std::predicate Predicate>
+inline auto ExponentialBackoff(ExponentialConfig config, F &&retryable, Predicate &&predicate)
+    -> std::invoke_result_t<F> {
+    return detail::ExponentialBackoffImpl(config, std::forward<F>(retryable), std::forward<Predicate>(predicate),
+                                          [](ExponentialConfig::Duration wait) { std::this_thread::sleep_for(wait); });
+}
+
 template <std::invocable F>
 inline auto ExponentialBackoff(ExponentialConfig config, F &&retryable) -> std::invoke_result_t<F> {
     return ExponentialBackoff(config, std::forward<F>(retryable), [] { return false; });
 }
 
+/**
+ * @brief Stops retrying once stop is requested, waits between attempts are cut short by the stop request
+ */
 template <std::invocable F>
 inline auto ExponentialBackoff(ExponentialConfig config, F &&retryable, const std::stop_token &stoken)
     -> std::invoke_result_t<F> {
-    return ExponentialBackoff(config, std::forward<F>(retryable), [&stoken] { return stoken.stop_requested(); });
+    std::mutex mtx;
+    std::condition_variable_any cv;
+
+    return detail::ExponentialBackoffImpl(
+        config, std::forward<F>(retryable), [&stoken] { return stoken.stop_requested(); },
+        [&](ExponentialConfig::Duration wait) {
+            std::unique_lock lock{mtx};
+            cv.wait_for(lock, stoken, wait, [] { return false; });
+        });
 }
 
 }  // namespace oryx::crt::retry
\ No newline at end of file
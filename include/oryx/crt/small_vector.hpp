@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "scope_exit.hpp"
+
+namespace oryx::crt {
+
+/**
+ * @brief Vector storing up to N elements inline, only allocates once it grows beyond that
+ */
+template <class T, size_t N>
+    requires(N > 0)
+class SmallVector {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_type kInlineCapacity = N;
+
+    SmallVector() noexcept = default;
+
+    SmallVector(std::initializer_list<T> init) {
+        reserve(init.size());
+        for (const auto& value : init) {
+            emplace_back(value);
+        }
+    }
+
+    SmallVector(const SmallVector& other) {
+        reserve(other.size_);
+        for (const auto& value : other) {
+            emplace_back(value);
+        }
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) { MoveFrom(other); }
+
+    auto operator=(const SmallVector& other) -> SmallVector& {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            for (const auto& value : other) {
+                emplace_back(value);
+            }
+        }
+        return *this;
+    }
+
+    auto operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) -> SmallVector& {
+        if (this != &other) {
+            clear();
+            Deallocate();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        Deallocate();
+    }
+
+    template <class... Args>
+    auto emplace_back(Args&&... args) -> T& {
+        if (size_ == capacity_) {
+            return GrowAndEmplaceBack(std::forward<Args>(args)...);
+        }
+        auto* value = std::construct_at(data_ + size_, std::forward<Args>(args)...);
+        ++size_;
+        return *value;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() { std::destroy_at(data_ + --size_); }
+
+    void clear() noexcept {
+        std::destroy_n(data_, size_);
+        size_ = 0;
+    }
+
+    void reserve(size_type capacity) {
+        if (capacity > capacity_) {
+            Relocate(capacity);
+        }
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type { return size_; }
+    [[nodiscard]] auto capacity() const noexcept -> size_type { return capacity_; }
+    [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+    [[nodiscard]] auto IsInline() const noexcept -> bool { return data_ == InlineData(); }
+
+    [[nodiscard]] auto data() noexcept -> T* { return data_; }
+    [[nodiscard]] auto data() const noexcept -> const T* { return data_; }
+
+    [[nodiscard]] auto begin() noexcept -> iterator { return data_; }
+    [[nodiscard]] auto begin() const noexcept -> const_iterator { return data_; }
+    [[nodiscard]] auto end() noexcept -> iterator { return data_ + size_; }
+    [[nodiscard]] auto end() const noexcept -> const_iterator { return data_ + size_; }
+
+    [[nodiscard]] auto operator[](size_type index) noexcept -> reference { return data_[index]; }
+    [[nodiscard]] auto operator[](size_type index) const noexcept -> const_reference { return data_[index]; }
+
+    [[nodiscard]] auto front() noexcept -> reference { return data_[0]; }
+    [[nodiscard]] auto front() const noexcept -> const_reference { return data_[0]; }
+    [[nodiscard]] auto back() noexcept -> reference { return data_[size_ - 1]; }
+    [[nodiscard]] auto back() const noexcept -> const_reference { return data_[size_ - 1]; }
+
+private:
+    auto InlineData() noexcept -> T* { return reinterpret_cast<T*>(inline_); }
+    auto InlineData() const noexcept -> const T* { return reinterpret_cast<const T*>(inline_); }
+
+    template <class... Args>
+    auto GrowAndEmplaceBack(Args&&... args) -> T& {
+        // Construct the new element first, args may refer to an element of this vector
+        auto capacity = capacity_ * 2;
+        T* storage = std::allocator<T>{}.allocate(capacity);
+        ScopeExit free_storage{[&] { std::allocator<T>{}.deallocate(storage, capacity); }};
+        auto* value = std::construct_at(storage + size_, std::forward<Args>(args)...);
+        ScopeExit destroy_value{[&] { std::destroy_at(value); }};
+        Adopt(storage, capacity);
+        destroy_value.Release();
+        free_storage.Release();
+        ++size_;
+        return *value;
+    }
+
+    void Relocate(size_type capacity) {
+        T* storage = std::allocator<T>{}.allocate(capacity);
+        ScopeExit free_storage{[&] { std::allocator<T>{}.deallocate(storage, capacity); }};
+        Adopt(storage, capacity);
+        free_storage.Release();
+    }
+
+    // Only throws while moving the elements, before this vector changes, storage then still belongs to the caller
+    void Adopt(T* storage, size_type capacity) {
+        std::uninitialized_move_n(data_, size_, storage);
+        std::destroy_n(data_, size_);
+        Deallocate();
+        data_ = storage;
+        capacity_ = capacity;
+    }
+
+    void Deallocate() noexcept {
+        if (!IsInline()) {
+            std::allocator<T>{}.deallocate(data_, capacity_);
+            data_ = InlineData();
+            capacity_ = N;
+        }
+    }
+
+    void MoveFrom(SmallVector& other) {
+        if (other.IsInline()) {
+            std::uninitialized_move_n(other.data_, other.size_, data_);
+            size_ = other.size_;
+            other.clear();
+            return;
+        }
+
+        data_ = std::exchange(other.data_, other.InlineData());
+        size_ = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, N);
+    }
+
+    alignas(T) std::byte inline_[N * sizeof(T)];
+    T* data_{InlineData()};
+    size_type size_{};
+    size_type capacity_{N};
+};
+
+}  // namespace oryx::crt
\ No newline at end of file
@@ -1,24 +1,320 @@
 #pragma once
 
+#include <array>
+#include <bit>
 #include <vector>
+#include <span>
+#include <ranges>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <string_view>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #include <immintrin.h>
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
 
 // NOTE: If you are running with C++23 use std::views::split which does not need memory allocation.
 // https://en.cppreference.com/w/cpp/ranges/split_view.html
 
 namespace oryx::crt {
+namespace detail {
+
+/**
+ * @brief Set of single character delimiters
+ */
+class DelimiterSet {
+public:
+    // Sets up to this size are scanned with SIMD, larger ones fall back to the lookup table
+    static constexpr size_t kMaxSimdSize = 8;
+
+    constexpr DelimiterSet() = default;
+
+    constexpr DelimiterSet(const char* delims)
+        : DelimiterSet(std::string_view(delims)) {}
+
+    constexpr DelimiterSet(std::string_view delims)
+        : size_(delims.size()) {
+        for (size_t i = 0; i < delims.size(); ++i) {
+            auto c = static_cast<uint8_t>(delims[i]);
+            table_[c / 64] |= uint64_t{1} << (c % 64);
+            if (i < kMaxSimdSize) {
+                chars_[i] = delims[i];
+            }
+        }
+    }
+
+    [[nodiscard]] constexpr auto Contains(char c) const -> bool {
+        auto u = static_cast<uint8_t>(c);
+        return (table_[u / 64] >> (u % 64)) & 1;
+    }
+
+    [[nodiscard]] constexpr auto Chars() const -> std::string_view {
+        return {chars_.data(), size_ < kMaxSimdSize ? size_ : kMaxSimdSize};
+    }
+    [[nodiscard]] constexpr auto IsSimdEligible() const -> bool { return size_ > 0 && size_ <= kMaxSimdSize; }
+
+private:
+    std::array<uint64_t, 4> table_{};
+    std::array<char, kMaxSimdSize> chars_{};
+    size_t size_{};
+};
+
+/**
+ * @brief Delimiter hits of the last SIMD block scanned for one input
+ *
+ * The next field usually starts inside the same block, searches landing in [begin, end) consume the remaining mask
+ * bits instead of loading and comparing the block again.
+ */
+struct DelimiterCursor {
+#if defined(__ARM_NEON) && !(defined(__x86_64__) || defined(_M_X64))
+    // NEON masks carry 4 bits per byte
+    static constexpr unsigned kStride = 4;
+#else
+    static constexpr unsigned kStride = 1;
+#endif
+
+    size_t begin{};
+    size_t end{};
+    // Bit (i * kStride) is set if input[begin + i] is a delimiter
+    uint64_t mask{};
+};
+
+// Single character delimiters go through memchr and carry no state
+struct NoCursor {};
+
+template <class Delimiter>
+using CursorFor = std::conditional_t<std::is_same_v<Delimiter, DelimiterSet>, DelimiterCursor, NoCursor>;
+
+constexpr auto FindFirstOfScalar(std::string_view input, size_t pos, const DelimiterSet& set) -> size_t {
+    for (; pos < input.size(); ++pos) {
+        if (set.Contains(input[pos])) {
+            return pos;
+        }
+    }
+    return std::string_view::npos;
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+inline auto FindFirstOfSse2(std::string_view input, size_t pos, const DelimiterSet& set, DelimiterCursor& cursor)
+    -> size_t {
+    auto chars = set.Chars();
+    __m128i needles[DelimiterSet::kMaxSimdSize];
+    for (size_t i = 0; i < chars.size(); ++i) {
+        needles[i] = _mm_set1_epi8(chars[i]);
+    }
+
+    for (; pos + 16 <= input.size(); pos += 16) {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + pos));
+        auto hits = _mm_cmpeq_epi8(block, needles[0]);
+        for (size_t i = 1; i < chars.size(); ++i) {
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, needles[i]));
+        }
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            cursor = {pos, pos + 16, mask};
+            return pos + std::countr_zero(mask);
+        }
+    }
+    return FindFirstOfScalar(input, pos, set);
+}
+
+    #if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+    #endif
+inline auto FindFirstOfAvx2(std::string_view input, size_t pos, const DelimiterSet& set, DelimiterCursor& cursor)
+    -> size_t {
+    auto chars = set.Chars();
+    __m256i needles[DelimiterSet::kMaxSimdSize];
+    for (size_t i = 0; i < chars.size(); ++i) {
+        needles[i] = _mm256_set1_epi8(chars[i]);
+    }
+
+    for (; pos + 32 <= input.size(); pos += 32) {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.data() + pos));
+        auto hits = _mm256_cmpeq_epi8(block, needles[0]);
+        for (size_t i = 1; i < chars.size(); ++i) {
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, needles[i]));
+        }
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            cursor = {pos, pos + 32, mask};
+            return pos + std::countr_zero(mask);
+        }
+    }
+    return FindFirstOfSse2(input, pos, set, cursor);
+}
+
+inline auto HasAvx2() -> bool {
+    #if defined(__AVX2__)
+    return true;
+    #elif defined(__GNUC__) || defined(__clang__)
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+    #else
+    return false;
+    #endif
+}
+
+inline auto FindFirstOfSimd(std::string_view input, size_t pos, const DelimiterSet& set, DelimiterCursor& cursor)
+    -> size_t {
+    return HasAvx2() ? FindFirstOfAvx2(input, pos, set, cursor) : FindFirstOfSse2(input, pos, set, cursor);
+}
+
+#elif defined(__ARM_NEON)
+
+inline auto FindFirstOfSimd(std::string_view input, size_t pos, const DelimiterSet& set, DelimiterCursor& cursor)
+    -> size_t {
+    auto chars = set.Chars();
+    uint8x16_t needles[DelimiterSet::kMaxSimdSize];
+    for (size_t i = 0; i < chars.size(); ++i) {
+        needles[i] = vdupq_n_u8(static_cast<uint8_t>(chars[i]));
+    }
+
+    for (; pos + 16 <= input.size(); pos += 16) {
+        auto block = vld1q_u8(reinterpret_cast<const uint8_t*>(input.data() + pos));
+        auto hits = vceqq_u8(block, needles[0]);
+        for (size_t i = 1; i < chars.size(); ++i) {
+            hits = vorrq_u8(hits, vceqq_u8(block, needles[i]));
+        }
+        // Narrow to 4 bits per byte, NEON has no movemask
+        auto mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+        if (mask != 0) {
+            cursor = {pos, pos + 16, mask};
+            return pos + std::countr_zero(mask) / 4;
+        }
+    }
+    return FindFirstOfScalar(input, pos, set);
+}
+
+#else
+
+inline auto FindFirstOfSimd(std::string_view input, size_t pos, const DelimiterSet& set, DelimiterCursor&)
+    -> size_t {
+    return FindFirstOfScalar(input, pos, set);
+}
+
+#endif
+
+constexpr auto FindDelimiter(std::string_view input, size_t pos, char delim, NoCursor&) -> size_t {
+    // Already vectorized, compiles down to memchr
+    return input.find(delim, pos);
+}
+
+constexpr auto FindDelimiter(std::string_view input, size_t pos, const DelimiterSet& set, DelimiterCursor& cursor)
+    -> size_t {
+    if (std::is_constant_evaluated() || !set.IsSimdEligible()) {
+        return FindFirstOfScalar(input, pos, set);
+    }
+    if (pos >= cursor.begin && pos < cursor.end) {
+        if (auto mask = cursor.mask >> ((pos - cursor.begin) * DelimiterCursor::kStride); mask != 0) {
+            return pos + std::countr_zero(mask) / DelimiterCursor::kStride;
+        }
+        pos = cursor.end;
+    }
+    return FindFirstOfSimd(input, pos, set, cursor);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Lazy range over the fields of input, yields the same fields as StringSplit without allocating
+ */
+template <class Delimiter>
+class BasicStringSplitView : public std::ranges::view_interface<BasicStringSplitView<Delimiter>> {
+public:
+    class Iterator {
+    public:
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        constexpr Iterator() = default;
+
+        constexpr auto operator*() const -> std::string_view { return input_.substr(pos_, next_ - pos_); }
+
+        constexpr auto operator++() -> Iterator& {
+            if (next_ == input_.size()) {
+                pos_ = std::string_view::npos;
+            } else {
+                pos_ = next_ + 1;
+                next_ = FindNext();
+            }
+            return *this;
+        }
+
+        constexpr auto operator++(int) -> Iterator {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        constexpr auto operator==(const Iterator& other) const -> bool { return pos_ == other.pos_; }
+        constexpr auto operator==(std::default_sentinel_t) const -> bool { return pos_ == std::string_view::npos; }
+
+    private:
+        friend class BasicStringSplitView;
+
+        constexpr Iterator(std::string_view input, const Delimiter& delim)
+            : input_(input),
+              delim_(delim),
+              pos_(0),
+              next_(FindNext()) {}
+
+        constexpr auto FindNext() -> size_t {
+            auto delim_pos = detail::FindDelimiter(input_, pos_, delim_, cursor_);
+            return delim_pos == std::string_view::npos ? input_.size() : delim_pos;
+        }
+
+        std::string_view input_{};
+        Delimiter delim_{};
+        // Declared before next_, the constructor initializes next_ with a search
+        [[no_unique_address]] detail::CursorFor<Delimiter> cursor_{};
+        size_t pos_{std::string_view::npos};
+        size_t next_{std::string_view::npos};
+    };
+
+    constexpr BasicStringSplitView() = default;
+
+    constexpr BasicStringSplitView(std::string_view input, Delimiter delim)
+        : input_(input),
+          delim_(delim) {}
+
+    constexpr auto begin() const -> Iterator { return Iterator(input_, delim_); }
+    constexpr auto end() const -> std::default_sentinel_t { return std::default_sentinel; }
+
+private:
+    std::string_view input_{};
+    Delimiter delim_{};
+};
+
+using StringSplitView = BasicStringSplitView<char>;
+
+/**
+ * @brief Splits on any of the given delimiter characters
+ */
+using StringSplitAnyView = BasicStringSplitView<detail::DelimiterSet>;
+
 namespace detail {
 struct StringSplitFunctor {
     constexpr auto operator()(std::string_view input, char delim) const -> std::vector<std::string_view> {
         std::vector<std::string_view> result;
-        size_t delim_pos;
-        size_t pos{};
+        for (auto field : StringSplitView(input, delim)) {
+            result.emplace_back(field);
+        }
+        return result;
+    }
 
-        while ((delim_pos = input.find(delim, pos)) != std::string_view::npos) {
-            result.emplace_back(input.substr(pos, delim_pos - pos));
-            pos = delim_pos + 1;
+    constexpr auto operator()(std::string_view input, std::string_view delims) const
+        -> std::vector<std::string_view> {
+        std::vector<std::string_view> result;
+        for (auto field : StringSplitAnyView(input, delims)) {
+            result.emplace_back(field);
         }
-        result.emplace_back(input.substr(pos));  // Add the last part
         return result;
     }
 };
@@ -26,4 +322,51 @@ struct StringSplitFunctor {
 
 inline constexpr detail::StringSplitFunctor StringSplit{};
 
-}  // namespace oryx::crt
\ No newline at end of file
+namespace detail {
+
+template <class Delimiter>
+constexpr auto StringSplitIntoImpl(std::string_view input, const Delimiter& delim, std::span<std::string_view> out)
+    -> size_t {
+    if (out.empty()) {
+        return 0;
+    }
+
+    size_t count{};
+    size_t pos{};
+    size_t delim_pos;
+    CursorFor<Delimiter> cursor{};
+    while (count + 1 < out.size() &&
+           (delim_pos = FindDelimiter(input, pos, delim, cursor)) != std::string_view::npos) {
+        out[count++] = input.substr(pos, delim_pos - pos);
+        pos = delim_pos + 1;
+    }
+    out[count++] = input.substr(pos);
+    return count;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Split input into the caller provided buffer
+ *
+ * If input has more fields than out can hold, the last slot receives the unsplit remainder.
+ *
+ * @return Number of fields written to out
+ */
+constexpr auto StringSplitInto(std::string_view input, char delim, std::span<std::string_view> out) -> size_t {
+    return detail::StringSplitIntoImpl(input, delim, out);
+}
+
+/**
+ * @brief Same as above but splits on any of the characters in delims
+ */
+constexpr auto StringSplitInto(std::string_view input,
+                               const detail::DelimiterSet& delims,
+                               std::span<std::string_view> out) -> size_t {
+    return detail::StringSplitIntoImpl(input, delims, out);
+}
+
+}  // namespace oryx::crt
+
+template <class Delimiter>
+inline constexpr bool std::ranges::enable_borrowed_range<oryx::crt::BasicStringSplitView<Delimiter>> = true;
\ No newline at end of file
@@ -1,9 +1,198 @@
 #pragma once
 
+#include <span>
+#include <array>
 #include <string>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <functional>
+#include <string_view>
+#include <type_traits>
 
-namespace oryx::crt::uuid4 {
+namespace oryx::crt {
 
+namespace detail {
+
+// Two hex characters for every byte value
+inline constexpr auto kHexPairs = [] {
+    constexpr char kDigits[] = "0123456789abcdef";
+    std::array<char, 256 * 2> pairs{};
+    for (size_t i = 0; i < 256; ++i) {
+        pairs[i * 2] = kDigits[i >> 4];
+        pairs[i * 2 + 1] = kDigits[i & 0x0F];
+    }
+    return pairs;
+}();
+
+constexpr auto Broadcast(uint8_t byte) -> uint64_t { return uint64_t{byte} * 0x0101010101010101; }
+
+/**
+ * @brief SWAR decode of eight hex characters into four bytes, accepts upper and lower case
+ */
+constexpr auto DecodeHex8(const char* in, uint8_t* out) -> bool {
+    uint64_t chunk{};
+    for (size_t i = 0; i < 8; ++i) {
+        chunk |= uint64_t{static_cast<uint8_t>(in[i])} << (i * 8);
+    }
+    if (chunk & Broadcast(0x80)) {
+        return false;
+    }
+
+    // With every byte below 0x80 these sums cannot carry into the neighbouring byte
+    const uint64_t lower = chunk | Broadcast(0x20);
+    const uint64_t digits = (chunk + Broadcast(0x80 - '0')) & ~(chunk + Broadcast(0x7F - '9'));
+    const uint64_t letters = (lower + Broadcast(0x80 - 'a')) & ~(lower + Broadcast(0x7F - 'f'));
+    if (((digits | letters) & Broadcast(0x80)) != Broadcast(0x80)) {
+        return false;
+    }
+
+    // Nibble values, then pair them up: byte 2k becomes (v[2k] << 4) | v[2k + 1]
+    const uint64_t nibbles = (lower & Broadcast(0x0F)) + ((lower >> 6) & Broadcast(0x01)) * 9;
+    uint64_t packed = ((nibbles << 4) | (nibbles >> 8)) & 0x00FF00FF00FF00FF;
+    packed = (packed | (packed >> 8)) & 0x0000FFFF0000FFFF;
+    packed = packed | (packed >> 16);
+    for (size_t i = 0; i < 4; ++i) {
+        out[i] = static_cast<uint8_t>(packed >> (i * 8));
+    }
+    return true;
+}
+
+}  // namespace detail
+
+/**
+ * @brief 128 bit UUID stored as 16 bytes in RFC 9562 network order
+ *
+ * Ordering compares bytes lexicographically, which sorts version 7 UUIDs by creation time.
+ */
+class Uuid {
+public:
+    static constexpr size_t kStringSize = 36;
+
+    constexpr Uuid() = default;
+
+    constexpr explicit Uuid(const std::array<uint8_t, 16>& bytes)
+        : bytes_(bytes) {}
+
+    /**
+     * @brief Parse the canonical 8-4-4-4-12 hex form, upper and lower case digits are accepted
+     */
+    static constexpr auto Parse(std::string_view text) -> std::optional<Uuid> {
+        if (text.size() != kStringSize || text[8] != '-' || text[13] != '-' || text[18] != '-' || text[23] != '-') {
+            return std::nullopt;
+        }
+
+        // Stray dashes leave the tail zeroed, which fails to decode
+        char hex[32]{};
+        size_t pos{};
+        for (char c : text) {
+            if (c != '-') {
+                hex[pos++] = c;
+            }
+        }
+
+        Uuid uuid;
+        for (size_t i = 0; i < 4; ++i) {
+            if (!detail::DecodeHex8(hex + i * 8, uuid.bytes_.data() + i * 4)) {
+                return std::nullopt;
+            }
+        }
+        return uuid;
+    }
+
+    /**
+     * @brief Write the lower case canonical form, exactly kStringSize characters and no terminator
+     */
+    constexpr auto FormatTo(char* out) const -> char* {
+        for (size_t i = 0; i < bytes_.size(); ++i) {
+            if (i == 4 || i == 6 || i == 8 || i == 10) {
+                *out++ = '-';
+            }
+            *out++ = detail::kHexPairs[bytes_[i] * 2];
+            *out++ = detail::kHexPairs[bytes_[i] * 2 + 1];
+        }
+        return out;
+    }
+
+    [[nodiscard]] constexpr auto ToChars() const -> std::array<char, kStringSize> {
+        std::array<char, kStringSize> chars{};
+        FormatTo(chars.data());
+        return chars;
+    }
+
+    [[nodiscard]] auto ToString() const -> std::string {
+        std::string str(kStringSize, '\0');
+        FormatTo(str.data());
+        return str;
+    }
+
+    [[nodiscard]] constexpr auto Bytes() const noexcept -> const std::array<uint8_t, 16>& { return bytes_; }
+    [[nodiscard]] constexpr auto Version() const noexcept -> int { return bytes_[6] >> 4; }
+    [[nodiscard]] constexpr auto IsNil() const noexcept -> bool { return *this == Uuid{}; }
+
+    friend constexpr auto operator<=>(const Uuid&, const Uuid&) = default;
+
+private:
+    std::array<uint8_t, 16> bytes_{};
+};
+
+static_assert(sizeof(Uuid) == 16 && std::is_trivially_copyable_v<Uuid>);
+
+namespace uuid4 {
+
+/**
+ * @brief Random UUID drawn from std::random_device, suitable where the identifier must not be guessable
+ */
 auto Generate() -> std::string;
 
-}  // namespace oryx::crt::uuid4
\ No newline at end of file
+/**
+ * @brief Random UUID drawn from a thread local xoshiro256** generator seeded once per thread
+ *
+ * Much faster than Generate() and does not allocate, but the output is predictable to anyone who observed enough
+ * previous values. Do not use it for session ids, tokens or anything security related.
+ */
+auto GenerateFast() -> std::array<char, 36>;
+
+/**
+ * @brief Same generator as GenerateFast() without the hex encoding
+ */
+auto GenerateBinary() -> Uuid;
+
+/**
+ * @brief Fill out with UUIDs from the GenerateFast() generator, one random stream for the whole batch
+ */
+void GenerateMany(std::span<Uuid> out);
+
+/**
+ * @brief Write count canonical UUIDs back to back to out, which must hold count * Uuid::kStringSize characters
+ */
+void GenerateInto(char* out, size_t count);
+
+}  // namespace uuid4
+
+namespace uuid7 {
+
+/**
+ * @brief Time ordered UUID, a 48 bit unix millisecond timestamp followed by random bits
+ *
+ * UUIDs generated on the same thread are strictly increasing, a 12 bit counter orders those within one millisecond.
+ * Random bits come from the same non cryptographic generator as uuid4::GenerateFast().
+ */
+auto Generate() -> Uuid;
+
+}  // namespace uuid7
+
+}  // namespace oryx::crt
+
+template <>
+struct std::hash<oryx::crt::Uuid> {
+    auto operator()(const oryx::crt::Uuid& uuid) const noexcept -> size_t {
+        uint64_t words[2];
+        std::memcpy(words, uuid.Bytes().data(), sizeof(words));
+        // The halves of version 7 UUIDs differ in entropy, mix so either one spreads over all bits
+        uint64_t hash = (words[0] ^ (words[1] * 0x9E3779B97F4A7C15)) * 0xBF58476D1CE4E5B9;
+        return static_cast<size_t>(hash ^ (hash >> 31));
+    }
+};
@@ -0,0 +1,207 @@
+#include <oryx/crt/record_reader.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+namespace oryx::crt {
+
+MappedFile::MappedFile(FILE* file) {
+#ifndef _WIN32
+    if (!file) {
+        return;
+    }
+
+    int fd = fileno(file);
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        return;
+    }
+
+    if (st.st_size == 0) {
+        valid_ = true;
+        return;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        return;
+    }
+
+    data_ = static_cast<const char*>(data);
+    size_ = static_cast<size_t>(st.st_size);
+    valid_ = true;
+#else
+    (void)file;
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      valid_(std::exchange(other.valid_, false)) {}
+
+auto MappedFile::operator=(MappedFile&& other) noexcept -> MappedFile& {
+    if (this != &other) {
+        Unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        valid_ = std::exchange(other.valid_, false);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() { Unmap(); }
+
+auto MappedFile::Open(std::string_view file_name) -> MappedFile {
+    // The mapping stays valid after the descriptor is closed
+    auto file = OpenFile(file_name, "rb");
+    return MappedFile(file.get());
+}
+
+void MappedFile::AdviseSequential() const {
+#ifndef _WIN32
+    if (data_) {
+        madvise(const_cast<char*>(data_), size_, MADV_SEQUENTIAL);
+    }
+#endif
+}
+
+void MappedFile::Unmap() noexcept {
+#ifndef _WIN32
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    valid_ = false;
+}
+
+RecordReader::RecordReader(UniqueFilePtr file, char delim, size_t buffer_size)
+    : file_(std::move(file)),
+      mapped_(file_.get()),
+      remaining_(mapped_.View()),
+      buffer_(),
+      capacity_(buffer_size > 0 ? buffer_size : kDefaultBufferSize),
+      delim_(delim),
+      eof_(!file_) {
+#ifndef _WIN32
+    // Both paths bypass the FILE, continue where stdio says the caller stopped rather than where its buffer ends
+    off_t offset = file_ ? ftello(file_.get()) : -1;
+#endif
+
+    if (mapped_.IsValid()) {
+#ifndef _WIN32
+        if (offset > 0) {
+            remaining_.remove_prefix(std::min(static_cast<size_t>(offset), remaining_.size()));
+        }
+#endif
+        mapped_.AdviseSequential();
+        return;
+    }
+
+#ifndef _WIN32
+    if (file_) {
+        int fd = fileno(file_.get());
+        // ftello() fails for pipes, their FILE must not have been read from
+        offset = std::max(offset, off_t{0});
+        if (offset > 0) {
+            lseek(fd, offset, SEEK_SET);
+        }
+        posix_fadvise(fd, offset, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+}
+
+auto RecordReader::Next() -> std::optional<std::string_view> {
+    return mapped_.IsValid() ? NextMapped() : NextBuffered();
+}
+
+auto RecordReader::NextMapped() -> std::optional<std::string_view> {
+    if (remaining_.empty()) {
+        return std::nullopt;
+    }
+
+    auto delim_pos = remaining_.find(delim_);
+    if (delim_pos == std::string_view::npos) {
+        return std::exchange(remaining_, {});
+    }
+
+    auto record = remaining_.substr(0, delim_pos);
+    remaining_.remove_prefix(delim_pos + 1);
+    return record;
+}
+
+auto RecordReader::NextBuffered() -> std::optional<std::string_view> {
+    while (true) {
+        std::string_view pending{buffer_.get() + scanned_, end_ - scanned_};
+        auto delim_pos = pending.find(delim_);
+        if (delim_pos != std::string_view::npos) {
+            std::string_view record{buffer_.get() + begin_, scanned_ + delim_pos - begin_};
+            begin_ = scanned_ = scanned_ + delim_pos + 1;
+            return record;
+        }
+        scanned_ = end_;
+
+        if (eof_) {
+            if (begin_ == end_) {
+                return std::nullopt;
+            }
+            std::string_view record{buffer_.get() + begin_, end_ - begin_};
+            begin_ = end_;
+            return record;
+        }
+        Fill();
+    }
+}
+
+void RecordReader::Fill() {
+    if (!buffer_) {
+        buffer_ = std::make_unique_for_overwrite<char[]>(capacity_);
+    }
+
+    // Move the partial record to the front, grow if it occupies the whole buffer
+    size_t pending = end_ - begin_;
+    if (pending == capacity_) {
+        auto grown = std::make_unique_for_overwrite<char[]>(capacity_ * 2);
+        std::memcpy(grown.get(), buffer_.get() + begin_, pending);
+        buffer_ = std::move(grown);
+        capacity_ *= 2;
+    } else if (begin_ > 0) {
+        std::memmove(buffer_.get(), buffer_.get() + begin_, pending);
+    }
+    scanned_ -= begin_;
+    end_ = pending;
+    begin_ = 0;
+
+#ifndef _WIN32
+    auto bytes_read = read(fileno(file_.get()), buffer_.get() + end_, capacity_ - end_);
+    while (bytes_read < 0 && errno == EINTR) {
+        bytes_read = read(fileno(file_.get()), buffer_.get() + end_, capacity_ - end_);
+    }
+    auto failed = bytes_read < 0;
+#else
+    auto bytes_read = static_cast<std::ptrdiff_t>(fread(buffer_.get() + end_, 1, capacity_ - end_, file_.get()));
+    auto failed = bytes_read == 0 && ferror(file_.get());
+#endif
+    if (failed) {
+        read_error_.emplace(std::error_code(errno, std::generic_category()));
+    }
+    if (bytes_read <= 0) {
+        eof_ = true;
+        return;
+    }
+    end_ += static_cast<size_t>(bytes_read);
+}
+
+}  // namespace oryx::crt
\ No newline at end of file
@@ -1,38 +1,152 @@
 #include <oryx/crt/uuid.hpp>
 
+#include <bit>
+#include <span>
 #include <array>
-#include <format>
+#include <chrono>
 #include <random>
 #include <string>
-#include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 namespace oryx::crt {
 
+namespace {
+
+void SetVersion(std::array<uint8_t, 16>& bytes, uint8_t version) {
+    bytes[6] = static_cast<uint8_t>((bytes[6] & 0x0F) | (version << 4));
+
+    // set variant to RFC 4122
+    bytes[8] = (bytes[8] & 0x3F) | 0x80;
+}
+
+/**
+ * @brief xoshiro256** by Blackman and Vigna, small state and fast, not cryptographically secure
+ */
+class Xoshiro256 {
+public:
+    explicit Xoshiro256(std::random_device& rd) {
+        for (auto& word : state_) {
+            word = (uint64_t{rd()} << 32) | rd();
+        }
+    }
+
+    auto operator()() -> uint64_t {
+        const auto result = std::rotl(state_[1] * 5, 7) * 9;
+        const auto t = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = std::rotl(state_[3], 45);
+
+        return result;
+    }
+
+private:
+    std::array<uint64_t, 4> state_{};
+};
+
+auto ThreadLocalGenerator() -> Xoshiro256& {
+    thread_local Xoshiro256 generator = [] {
+        std::random_device rd;
+        return Xoshiro256(rd);
+    }();
+    return generator;
+}
+
+auto RandomBytes() -> std::array<uint8_t, 16> {
+    auto& generator = ThreadLocalGenerator();
+    const uint64_t words[2] = {generator(), generator()};
+
+    std::array<uint8_t, 16> bytes;
+    std::memcpy(bytes.data(), words, sizeof(words));
+    return bytes;
+}
+
+}  // namespace
+
 auto uuid4::Generate() -> std::string {
     std::random_device rd;
-    std::uniform_int_distribution<unsigned int> dis(0, 255);
 
-    // generate 16 random bytes
+    // generate 16 random bytes, random_device yields 32 bits per call
     std::array<uint8_t, 16> bytes;
-    std::ranges::generate(bytes, [&dis, &rd] { return static_cast<uint8_t>(dis(rd)); });
+    for (size_t i = 0; i < bytes.size(); i += 4) {
+        const uint32_t word = rd();
+        std::memcpy(bytes.data() + i, &word, sizeof(word));
+    }
+    SetVersion(bytes, 4);
+    return Uuid(bytes).ToString();
+}
 
-    // set version to 4
-    bytes[6] = (bytes[6] & 0x0F) | 0x40;
+auto uuid4::GenerateFast() -> std::array<char, 36> { return GenerateBinary().ToChars(); }
 
-    // set variant to RFC 4122
-    bytes[8] = (bytes[8] & 0x3F) | 0x80;
+auto uuid4::GenerateBinary() -> Uuid {
+    auto bytes = RandomBytes();
+    SetVersion(bytes, 4);
+    return Uuid(bytes);
+}
+
+void uuid4::GenerateMany(std::span<Uuid> out) {
+    static_assert(sizeof(Uuid) == 2 * sizeof(uint64_t));
+
+    // Draw the raw bits in one pass and patch the version afterwards, keeps both loops free of dependencies
+    auto& generator = ThreadLocalGenerator();
+    for (auto& uuid : out) {
+        const uint64_t words[2] = {generator(), generator()};
+        std::memcpy(&uuid, words, sizeof(words));
+    }
+    for (auto& uuid : out) {
+        auto bytes = uuid.Bytes();
+        SetVersion(bytes, 4);
+        uuid = Uuid(bytes);
+    }
+}
+
+void uuid4::GenerateInto(char* out, size_t count) {
+    // Batches bound the stack buffer while amortizing the generator access
+    constexpr size_t kBatchSize = 64;
+    std::array<Uuid, kBatchSize> batch;
+    while (count > 0) {
+        const size_t n = count < kBatchSize ? count : kBatchSize;
+        GenerateMany(std::span(batch).first(n));
+        for (size_t i = 0; i < n; ++i) {
+            out = batch[i].FormatTo(out);
+        }
+        count -= n;
+    }
+}
+
+auto uuid7::Generate() -> Uuid {
+    // Last timestamp and counter of this thread, RFC 9562 section 6.2 method 1
+    thread_local uint64_t last_ms{};
+    thread_local uint16_t counter{};
+
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    auto ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+
+    auto bytes = RandomBytes();
+    if (ms > last_ms) {
+        // Start low in the counter range so bursts within one millisecond rarely overflow it
+        counter = static_cast<uint16_t>((bytes[6] << 8 | bytes[7]) & 0x07FF);
+    } else if (++counter > 0x0FFF) {
+        // Clock went backwards or the counter is exhausted, borrow from the next millisecond
+        counter = 0;
+        ms = last_ms + 1;
+    } else {
+        ms = last_ms;
+    }
+    last_ms = ms;
 
-    return std::format(
-        "{0:02x}{1:02x}{2:02x}{3:02x}-"
-        "{4:02x}{5:02x}-"
-        "{6:02x}{7:02x}-"
-        "{8:02x}{9:02x}-"
-        "{10:02x}{11:02x}{12:02x}{13:02x}{14:02x}{15:02x}",
-        static_cast<int>(bytes[0]), static_cast<int>(bytes[1]), static_cast<int>(bytes[2]), static_cast<int>(bytes[3]),
-        static_cast<int>(bytes[4]), static_cast<int>(bytes[5]), static_cast<int>(bytes[6]), static_cast<int>(bytes[7]),
-        static_cast<int>(bytes[8]), static_cast<int>(bytes[9]), static_cast<int>(bytes[10]),
-        static_cast<int>(bytes[11]), static_cast<int>(bytes[12]), static_cast<int>(bytes[13]),
-        static_cast<int>(bytes[14]), static_cast<int>(bytes[15]));
+    for (size_t i = 0; i < 6; ++i) {
+        bytes[i] = static_cast<uint8_t>(ms >> (40 - i * 8));
+    }
+    bytes[6] = static_cast<uint8_t>(counter >> 8);
+    bytes[7] = static_cast<uint8_t>(counter);
+    SetVersion(bytes, 7);
+    return Uuid(bytes);
 }
 
-}  // namespace oryx::crt
\ No newline at end of file
+}  // namespace oryx::crt
@@ -2,6 +2,9 @@
 
 #include <oryx/crt/argparse.hpp>
 
+#include <string>
+#include <vector>
+
 using namespace oryx::crt;
 
 static constexpr int kArgc = 7;
@@ -70,3 +73,148 @@ TEST_CASE("VisitIfContains does not call visitor if arg present but parse fails"
     cli.VisitIfContains<float>("--string", [&](float parsed) { called = true; });
     CHECK_FALSE(called);
 }
+
+TEST_CASE("Get extended value types") {
+    using namespace std::chrono_literals;
+
+    static constexpr const char* kExtendedArgv[] = {"--mask", "0xff",    "--timeout", "250ms",
+                                                    "--size", "64MiB", "--verbose", "yes"};
+    auto cli = ArgumentParser(std::size(kExtendedArgv), kExtendedArgv);
+
+    CHECK(cli.GetValue<int>("--mask").value() == 255);
+    CHECK(cli.GetValue<std::chrono::milliseconds>("--timeout").value() == 250ms);
+    CHECK(cli.GetValue<ByteSize>("--size").value().bytes == 64ull << 20);
+    CHECK(cli.GetValue<bool>("--verbose").value());
+    CHECK_FALSE(cli.GetValue<std::chrono::milliseconds>("--mask"));
+}
+
+TEST_CASE("Inline values, short flags and positionals") {
+    static constexpr const char* kMixedArgv[] = {"-vx", "--level=3", "-o", "out.txt", "--offset", "-5",
+                                                 "input", "--", "--not-an-option"};
+    auto cli = ArgumentParser(std::size(kMixedArgv), kMixedArgv, {.group_short_flags = true});
+
+    CHECK(cli.GetValue<bool>("-v").value());
+    CHECK(cli.GetValue<bool>("-x").value());
+    CHECK(cli.GetValue<int>("--level").value() == 3);
+    CHECK(cli.GetValue<std::string>("-o").value() == "out.txt");
+    CHECK(cli.GetValue<int>("--offset").value() == -5);
+    CHECK(cli.Contains("--not-an-option"));
+    CHECK(cli.Count("--not-an-option") == 0);
+    CHECK_FALSE(cli.GetValue<bool>("--not-an-option"));
+
+    auto positionals = cli.Positionals();
+    REQUIRE(positionals.size() == 2);
+    CHECK(positionals[0] == "input");
+    CHECK(positionals[1] == "--not-an-option");
+    CHECK(cli.Contains("input"));
+}
+
+TEST_CASE("Single dash options are not grouped by default") {
+    static constexpr const char* kSingleDashArgv[] = {"-threads", "4", "-vx"};
+
+    auto cli = ArgumentParser(std::size(kSingleDashArgv), kSingleDashArgv);
+    CHECK(cli.GetValue<int>("-threads").value() == 4);
+    CHECK(cli.GetValue<bool>("-vx").value());
+    CHECK_FALSE(cli.Contains("-t"));
+    CHECK_FALSE(cli.Contains("-v"));
+
+    auto grouped = ArgumentParser(std::size(kSingleDashArgv), kSingleDashArgv, {.group_short_flags = true});
+    CHECK(grouped.Contains("-t"));
+    CHECK(grouped.GetValue<bool>("-v").value());
+    CHECK_FALSE(grouped.GetValue<int>("-threads"));
+}
+
+TEST_CASE("Bool options do not consume the next token") {
+    static constexpr const char* kFlagArgv[] = {"--verbose", "input.txt", "--color", "no", "--strict=maybe"};
+
+    auto cli = ArgumentParser(std::size(kFlagArgv), kFlagArgv);
+    CHECK(cli.GetValue<bool>("--verbose").value());
+    CHECK_FALSE(cli.GetValue<bool>("--color").value());
+    CHECK_FALSE(cli.GetValue<bool>("--strict"));
+    CHECK(cli.GetValue<std::string>("--verbose").value() == "input.txt");
+    CHECK(cli.Contains("input.txt"));
+
+    static constexpr std::string_view kFlags[] = {"--verbose"};
+    auto flagged = ArgumentParser(std::size(kFlagArgv), kFlagArgv, {.flags = kFlags});
+    CHECK(flagged.GetValue<bool>("--verbose").value());
+    CHECK_FALSE(flagged.GetValue<std::string>("--verbose"));
+    REQUIRE(flagged.Positionals().size() == 1);
+    CHECK(flagged.Positionals()[0] == "input.txt");
+}
+
+TEST_CASE("argv[0] is parsed like any other token") {
+    static constexpr const char* kMainArgv[] = {"./server", "--port", "80", "input.txt"};
+
+    auto cli = ArgumentParser(std::size(kMainArgv), kMainArgv);
+    CHECK(cli.Positionals().size() == 2);
+    CHECK(cli.Positionals()[0] == "./server");
+
+    auto skipped = ArgumentParser(std::size(kMainArgv) - 1, kMainArgv + 1);
+    CHECK(skipped.GetValue<int>("--port").value() == 80);
+    REQUIRE(skipped.Positionals().size() == 1);
+    CHECK(skipped.Positionals()[0] == "input.txt");
+}
+
+TEST_CASE("Repeated options") {
+    static constexpr const char* kRepeatedArgv[] = {"--include", "a", "--include=b", "--flag", "--include", "c"};
+    auto cli = ArgumentParser(std::size(kRepeatedArgv), kRepeatedArgv);
+
+    CHECK(cli.Count("--include") == 3);
+    CHECK(cli.GetValue<std::string>("--include").value() == "a");
+    CHECK(cli.GetValues<std::string>("--include").value() == std::vector<std::string>{"a", "b", "c"});
+    CHECK_FALSE(cli.GetValue<std::string>("--flag"));
+    CHECK(cli.GetValues<int>("--missing").value().empty());
+    CHECK_FALSE(cli.GetValues<int>("--include"));
+}
+
+TEST_CASE("Typed schema with defaults") {
+    static constexpr ArgumentSchema kSchema{Option<"--port", int>{8080},
+                                            Option<"--host", std::string_view>{"localhost"},
+                                            Option<"--verbose", bool>{}};
+
+    static constexpr const char* kSchemaArgv[] = {"--port=9000", "--verbose"};
+    auto args = kSchema.Parse(ArgumentParser(std::size(kSchemaArgv), kSchemaArgv));
+    REQUIRE(args.has_value());
+    CHECK(args->Get<"--port">() == 9000);
+    CHECK(args->Get<"--host">() == "localhost");
+    CHECK(args->Get<"--verbose">());
+
+    static constexpr const char* kInvalidArgv[] = {"--port", "http"};
+    CHECK_FALSE(kSchema.Parse(ArgumentParser(std::size(kInvalidArgv), kInvalidArgv)));
+
+    static constexpr const char* kFlagArgv[] = {"--verbose", "input.txt", "--port", "81"};
+    auto flag_args = kSchema.Parse(ArgumentParser(std::size(kFlagArgv), kFlagArgv));
+    REQUIRE(flag_args.has_value());
+    CHECK(flag_args->Get<"--verbose">());
+    CHECK(flag_args->Get<"--port">() == 81);
+
+    static_assert(kSchema.kFlags.size() == 1 && kSchema.kFlags[0] == "--verbose");
+    flag_args = kSchema.Parse(std::size(kFlagArgv), kFlagArgv);
+    REQUIRE(flag_args.has_value());
+    CHECK(flag_args->Get<"--verbose">());
+}
+
+TEST_CASE("Large generated argv") {
+    constexpr int kOptions = 50'000;
+
+    std::vector<std::string> storage;
+    storage.reserve(kOptions * 2);
+    for (int i = 0; i < kOptions; ++i) {
+        storage.push_back("--opt" + std::to_string(i));
+        storage.push_back(std::to_string(i));
+    }
+
+    std::vector<const char*> argv;
+    argv.reserve(storage.size());
+    for (const auto& arg : storage) {
+        argv.push_back(arg.c_str());
+    }
+
+    auto cli = ArgumentParser(static_cast<int>(argv.size()), argv.data());
+    REQUIRE(cli.Size() == argv.size());
+    for (int i = 0; i < kOptions; ++i) {
+        REQUIRE(cli.GetValue<int>("--opt" + std::to_string(i)).value() == i);
+    }
+    CHECK_FALSE(cli.Contains("--opt" + std::to_string(kOptions)));
+    CHECK(cli.Positionals().empty());
+}
@@ -0,0 +1,152 @@
+#include "doctest.hpp"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+#include <oryx/crt/async_retry.hpp>
+
+using namespace std::chrono_literals;
+using namespace oryx::crt;
+
+namespace {
+const retry::ExponentialConfig kDefaultConfig{.start_backoff = 1ms, .max_backoff = 4ms, .max_retries = 1};
+}
+
+TEST_CASE("AsyncRetrier retryable fails and succeeds") {
+    retry::AsyncRetrier::ThreadPool pool(1);
+    auto retrier = retry::AsyncRetrier::Create(pool);
+
+    CHECK_FALSE(retrier->ExponentialBackoff(kDefaultConfig, []() { return false; }).get());
+    CHECK(retrier->ExponentialBackoff(kDefaultConfig, []() { return true; }).get());
+}
+
+TEST_CASE("AsyncRetrier retryable succeeds after some tries") {
+    retry::AsyncRetrier::ThreadPool pool(1);
+    auto retrier = retry::AsyncRetrier::Create(pool);
+
+    std::atomic<int> tries_so_far = 0;
+    auto config = kDefaultConfig;
+    config.max_retries = 4;
+
+    CHECK(retrier->ExponentialBackoff(config, [&]() { return ++tries_so_far == 4; }).get());
+    CHECK_EQ(tries_so_far, 4);
+    CHECK_EQ(retrier->GetNumPending(), 0);
+}
+
+TEST_CASE("AsyncRetrier exhausting max retries") {
+    retry::AsyncRetrier::ThreadPool pool(1);
+    auto retrier = retry::AsyncRetrier::Create(pool);
+
+    std::atomic<int> tries_so_far = 0;
+    auto config = kDefaultConfig;
+    config.max_retries = 3;
+
+    CHECK_FALSE(retrier->ExponentialBackoff(config, [&]() { return ++tries_so_far == 4; }).get());
+    CHECK_EQ(tries_so_far, 3);
+}
+
+TEST_CASE("AsyncRetrier zero max retries never calls retryable") {
+    retry::AsyncRetrier::ThreadPool pool(1);
+    auto retrier = retry::AsyncRetrier::Create(pool);
+
+    bool called{};
+    auto config = kDefaultConfig;
+    config.max_retries = 0;
+
+    CHECK_FALSE(retrier->ExponentialBackoff(config, [&]() { return called = true; }).get());
+    CHECK_FALSE(called);
+}
+
+TEST_CASE("AsyncRetrier invokes callback with result") {
+    retry::AsyncRetrier::ThreadPool pool(1);
+    auto retrier = retry::AsyncRetrier::Create(pool);
+
+    std::promise<bool> done;
+    auto config = kDefaultConfig;
+    config.max_retries = 2;
+
+    int tries_so_far = 0;
+    retrier->ExponentialBackoff(
+        config, [&]() { return ++tries_so_far == 2; },
+        [&](bool result, std::exception_ptr error) { done.set_value(result && !error); });
+    CHECK(done.get_future().get());
+}
+
+TEST_CASE("AsyncRetrier passes exceptions to callback") {
+    retry::AsyncRetrier::ThreadPool pool(1);
+    auto retrier = retry::AsyncRetrier::Create(pool);
+
+    std::promise<std::exception_ptr> done;
+    retrier->ExponentialBackoff(
+        kDefaultConfig, []() -> bool { throw std::runtime_error("boom"); },
+        [&](bool result, std::exception_ptr error) {
+            CHECK_FALSE(result);
+            done.set_value(error);
+        });
+    auto error = done.get_future().get();
+    REQUIRE(error);
+    CHECK_THROWS_AS(std::rethrow_exception(error), std::runtime_error);
+}
+
+TEST_CASE("AsyncRetrier zero max retries invokes callback on a pool thread") {
+    retry::AsyncRetrier::ThreadPool pool(1);
+    auto retrier = retry::AsyncRetrier::Create(pool);
+
+    auto config = kDefaultConfig;
+    config.max_retries = 0;
+
+    std::promise<std::thread::id> done;
+    retrier->ExponentialBackoff(
+        config, []() { return true; }, [&](bool, std::exception_ptr) { done.set_value(std::this_thread::get_id()); });
+    CHECK_NE(done.get_future().get(), std::this_thread::get_id());
+}
+
+TEST_CASE("AsyncRetrier forwards exceptions to future") {
+    retry::AsyncRetrier::ThreadPool pool(1);
+    auto retrier = retry::AsyncRetrier::Create(pool);
+
+    auto future = retrier->ExponentialBackoff(kDefaultConfig, []() -> bool { throw std::runtime_error("boom"); });
+    CHECK_THROWS_AS(future.get(), std::runtime_error);
+}
+
+TEST_CASE("AsyncRetrier drives many concurrent loops") {
+    constexpr int kNumLoops = 2000;
+    constexpr int kTries = 3;
+
+    retry::AsyncRetrier::ThreadPool pool(2);
+    auto retrier = retry::AsyncRetrier::Create(pool);
+
+    auto config = kDefaultConfig;
+    config.max_retries = kTries;
+
+    std::vector<std::atomic<int>> tries(kNumLoops);
+    std::vector<std::future<bool>> futures;
+    futures.reserve(kNumLoops);
+    for (auto &counter : tries) {
+        futures.push_back(retrier->ExponentialBackoff(config, [&counter]() { return ++counter == kTries; }));
+    }
+
+    for (auto &future : futures) {
+        CHECK(future.get());
+    }
+    CHECK(std::ranges::all_of(tries, [](const auto &counter) { return counter == kTries; }));
+}
+
+TEST_CASE("AsyncRetrier abandons pending loops on destruction") {
+    retry::AsyncRetrier::ThreadPool pool(1);
+    auto retrier = retry::AsyncRetrier::Create(pool);
+
+    auto config = kDefaultConfig;
+    config.start_backoff = 10s;
+    config.max_backoff = 10s;
+    config.max_retries = 2;
+
+    auto future = retrier->ExponentialBackoff(config, []() { return false; });
+    while (retrier->GetNumPending() == 0) {
+        std::this_thread::sleep_for(1ms);
+    }
+    retrier.reset();
+    CHECK_THROWS_AS(future.get(), std::future_error);
+}
@@ -180,4 +180,21 @@ TEST_CASE("ErrorGroup method chaining") {
 
         CHECK(group.Size() == 3);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("ErrorGroup formatting") {
+    ErrorGroup group;
+    for (int i = 0; i < 12; ++i) {
+        group.Add(Error(std::format("Error {}", i)));
+    }
+
+    SUBCASE("std::format matches what()") { CHECK(std::format("{}", group) == group.what()); }
+
+    SUBCASE("FormattedSize matches rendered size") { CHECK(group.FormattedSize() == group.what().size()); }
+
+    SUBCASE("FormatTo writes to output iterator") {
+        std::string out;
+        group.FormatTo(std::back_inserter(out));
+        CHECK(out == group.what());
+    }
+}
@@ -1,6 +1,8 @@
 #include "doctest.hpp"
 
+#include <ostream>
 #include <string>
+#include <system_error>
 
 #include <oryx/crt/error.hpp>
 
@@ -11,3 +13,46 @@ TEST_CASE("What you give is what you get") {
     Error error{what};
     CHECK_EQ(what, error.what());
 }
+
+TEST_CASE("Literal error keeps a view to the static message") {
+    static constexpr const char* kMessage = "Static failure";
+    auto error = Error::Literal("Static failure");
+    CHECK_EQ(error.what(), kMessage);
+    CHECK_FALSE(error.code());
+
+    auto copy = error;
+    CHECK_EQ(copy.what().data(), error.what().data());
+}
+
+TEST_CASE("Error carries error code") {
+    auto error = Error::Literal("Invalid input", std::make_error_code(std::errc::invalid_argument));
+    CHECK(error.code() == std::errc::invalid_argument);
+
+    Error from_code{std::make_error_code(std::errc::timed_out)};
+    CHECK(from_code.code() == std::errc::timed_out);
+    CHECK_FALSE(from_code.what().empty());
+}
+
+TEST_CASE("Copied and moved errors own their message") {
+    std::string long_message(64, 'x');
+    std::string short_message{"short"};
+
+    for (const auto& message : {long_message, short_message}) {
+        Error original{message};
+
+        Error copy{original};
+        CHECK_EQ(copy.what(), message);
+        CHECK_NE(copy.what().data(), original.what().data());
+
+        Error moved{std::move(original)};
+        CHECK_EQ(moved.what(), message);
+
+        Error assigned = Error::Literal("placeholder");
+        assigned = moved;
+        CHECK_EQ(assigned.what(), message);
+        assigned = Error::Literal("placeholder");
+        CHECK_EQ(assigned.what(), "placeholder");
+        assigned = std::move(moved);
+        CHECK_EQ(assigned.what(), message);
+    }
+}
@@ -2,6 +2,11 @@
 
 #include "doctest.hpp"
 
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
 using namespace oryx::crt;
 
 TEST_CASE("Parsing valid values") {
@@ -20,4 +25,132 @@ TEST_CASE("Parsing invalid values") {
     CHECK_FALSE(FromChars<float>("are"));
     CHECK_FALSE(FromChars<double>("you"));
     CHECK_FALSE(FromChars<bool>("reading"));
-}
\ No newline at end of file
+}
+TEST_CASE("Batch parsing matches FromChars") {
+    std::mt19937_64 rng{7};
+    std::vector<std::string> storage;
+    for (int i = 0; i < 2000; ++i) {
+        switch (rng() % 6) {
+            case 0:
+                storage.push_back(std::to_string(static_cast<int64_t>(rng())));
+                break;
+            case 1:
+                storage.push_back(std::to_string(rng() % 100000000));
+                break;
+            case 2:
+                storage.push_back(std::to_string(rng()));
+                break;
+            case 3:
+                storage.push_back(std::to_string(rng() % 1000) + "x");
+                break;
+            case 4:
+                storage.push_back("-" + std::to_string(rng() % 1000000000000));
+                break;
+            default:
+                storage.push_back(i % 2 ? "" : "12a45678901");
+                break;
+        }
+    }
+    storage.push_back("9223372036854775807");
+    storage.push_back("-9223372036854775808");
+    storage.push_back("99999999999999999999");
+    std::vector<std::string_view> fields(storage.begin(), storage.end());
+
+    auto check = [&]<typename T>(T) {
+        std::vector<T> out(fields.size());
+        std::vector<uint64_t> valid((fields.size() + 63) / 64, ~uint64_t{0});
+        auto num_valid = FromCharsBatch<T>(fields, out, valid);
+
+        size_t expected_valid{};
+        for (size_t i = 0; i < fields.size(); ++i) {
+            auto expected = FromChars<T>(fields[i]);
+            bool is_valid = (valid[i / 64] >> (i % 64)) & 1;
+            REQUIRE_EQ(is_valid, expected.has_value());
+            CHECK_EQ(out[i], expected.value_or(T{}));
+            expected_valid += expected.has_value();
+        }
+        CHECK_EQ(num_valid, expected_valid);
+    };
+
+    check(int64_t{});
+    check(uint64_t{});
+    check(int32_t{});
+    check(uint16_t{});
+    check(double{});
+}
+
+TEST_CASE("FromCharsBatch stops at the smallest output") {
+    std::vector<std::string_view> fields(100, "7");
+
+    std::vector<int> short_out(10, -1);
+    std::vector<uint64_t> valid(2, 0);
+    CHECK_EQ(FromCharsBatch<int>(fields, short_out, valid), 10);
+    CHECK_EQ(valid[0], (uint64_t{1} << 10) - 1);
+    CHECK_EQ(valid[1], 0);
+
+    std::vector<int> out(fields.size(), -1);
+    std::vector<uint64_t> short_valid(1, 0);
+    CHECK_EQ(FromCharsBatch<int>(fields, out, short_valid), 64);
+    CHECK_EQ(short_valid[0], ~uint64_t{0});
+    CHECK_EQ(out[63], 7);
+    CHECK_EQ(out[64], -1);
+}
+
+TEST_CASE("Parsing bool words") {
+    CHECK(FromChars<bool>("true").value());
+    CHECK(FromChars<bool>("Yes").value());
+    CHECK(FromChars<bool>("ON").value());
+    CHECK_FALSE(FromChars<bool>("false").value());
+    CHECK_FALSE(FromChars<bool>("no").value());
+    CHECK_FALSE(FromChars<bool>("Off").value());
+    CHECK_FALSE(FromChars<bool>("truee"));
+    static_assert(FromChars<bool>("TRUE").value());
+}
+
+TEST_CASE("Parsing base prefixed integers") {
+    CHECK(FromCharsPrefixed<int>("42").value() == 42);
+    CHECK(FromCharsPrefixed<int>("-42").value() == -42);
+    CHECK(FromCharsPrefixed<int>("0x1F").value() == 31);
+    CHECK(FromCharsPrefixed<int>("0o17").value() == 15);
+    CHECK(FromCharsPrefixed<int>("0b101").value() == 5);
+    CHECK(FromCharsPrefixed<int8_t>("-128").value() == -128);
+    CHECK(FromCharsPrefixed<uint64_t>("0xFFFFFFFFFFFFFFFF").value() == UINT64_MAX);
+    CHECK_FALSE(FromCharsPrefixed<int8_t>("128"));
+    CHECK_FALSE(FromCharsPrefixed<unsigned>("-1"));
+    CHECK_FALSE(FromCharsPrefixed<int>("0x"));
+    CHECK_FALSE(FromCharsPrefixed<int>("0b102"));
+    CHECK_FALSE(FromCharsPrefixed<int>("12abc"));
+    CHECK_FALSE(FromCharsPrefixed<uint64_t>("0x1FFFFFFFFFFFFFFFF"));
+    static_assert(FromCharsPrefixed<int>("0xff").value() == 255);
+}
+
+TEST_CASE("Parsing durations") {
+    using namespace std::chrono_literals;
+
+    CHECK(FromChars<std::chrono::milliseconds>("250ms").value() == 250ms);
+    CHECK(FromChars<std::chrono::milliseconds>("2s").value() == 2000ms);
+    CHECK(FromChars<std::chrono::seconds>("5min").value() == 300s);
+    CHECK(FromChars<std::chrono::seconds>("5m").value() == 300s);
+    CHECK(FromChars<std::chrono::hours>("2d").value() == 48h);
+    CHECK(FromChars<std::chrono::nanoseconds>("7us").value() == 7000ns);
+    CHECK(FromChars<std::chrono::duration<double>>("1500ms").value().count() == 1.5);
+    CHECK_FALSE(FromChars<std::chrono::seconds>("1500ms"));
+    CHECK_FALSE(FromChars<std::chrono::seconds>("10"));
+    CHECK_FALSE(FromChars<std::chrono::seconds>("ms"));
+    CHECK_FALSE(FromChars<std::chrono::seconds>("10 s"));
+    CHECK_FALSE(FromChars<std::chrono::nanoseconds>("200000d"));
+    static_assert(FromChars<std::chrono::milliseconds>("1h").value() == 1h);
+}
+
+TEST_CASE("Parsing byte sizes") {
+    CHECK(FromChars<ByteSize>("512").value().bytes == 512);
+    CHECK(FromChars<ByteSize>("512B").value().bytes == 512);
+    CHECK(FromChars<ByteSize>("64MiB").value().bytes == 64ull << 20);
+    CHECK(FromChars<ByteSize>("64mib").value().bytes == 64ull << 20);
+    CHECK(FromChars<ByteSize>("10kb").value().bytes == 10000);
+    CHECK(FromChars<ByteSize>("1TiB").value().bytes == 1ull << 40);
+    CHECK_FALSE(FromChars<ByteSize>("1PiB"));
+    CHECK_FALSE(FromChars<ByteSize>("MiB"));
+    CHECK_FALSE(FromChars<ByteSize>("20000000TiB"));
+    static_assert(FromChars<ByteSize>("2GiB").value() == ByteSize{2ull << 30});
+}
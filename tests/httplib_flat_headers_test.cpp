@@ -0,0 +1,92 @@
+// Built into its own test executable with CPPHTTPLIB_FLAT_HEADERS, Headers has a different type there
+#include "doctest.hpp"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <oryx/crt/httplib.hpp>
+
+static_assert(std::is_same_v<httplib::Headers, httplib::detail::FlatHeaders>);
+static_assert(std::is_same_v<httplib::Headers::value_type, std::pair<std::string, std::string>>);
+
+TEST_CASE("FlatHeaders groups fields with equal names") {
+    httplib::Headers headers;
+    headers.emplace("Accept", "text/html");
+    headers.emplace("Host", "example.com");
+    headers.emplace("accept", "application/json");
+    headers.insert({"Via", "1.1 proxy"});
+    headers.emplace("ACCEPT", "*/*");
+
+    std::vector<std::pair<std::string, std::string>> fields;
+    for (const auto &[name, value] : headers) {
+        fields.emplace_back(name, value);
+    }
+    CHECK(fields == std::vector<std::pair<std::string, std::string>>{{"Accept", "text/html"},
+                                                                     {"accept", "application/json"},
+                                                                     {"ACCEPT", "*/*"},
+                                                                     {"Host", "example.com"},
+                                                                     {"Via", "1.1 proxy"}});
+}
+
+TEST_CASE("FlatHeaders lookup ignores case") {
+    httplib::Headers headers{{"Content-Type", "text/plain"}, {"X-Long-Header-Name-Over-Eight", "1"}};
+
+    REQUIRE(headers.find("content-type") != headers.end());
+    CHECK(headers.find("CONTENT-TYPE")->second == "text/plain");
+    CHECK(headers.find("x-long-header-name-over-eight")->second == "1");
+    CHECK(headers.find("Content-Typ") == headers.end());
+    CHECK(headers.find("x-long-header-name-over-eighT") != headers.end());
+    CHECK(headers.find("x-long-header-name-over-eighX") == headers.end());
+}
+
+TEST_CASE("FlatHeaders equal_range, count and erase") {
+    httplib::Headers headers;
+    headers.emplace("Set-Cookie", "a=1");
+    headers.emplace("Host", "example.com");
+    headers.emplace("set-cookie", "b=2");
+    const httplib::Headers::value_type cookie{"SET-COOKIE", "c=3"};
+    headers.insert(cookie);
+
+    CHECK(headers.count("set-cookie") == 3);
+    CHECK(headers.count("host") == 1);
+    CHECK(headers.count("missing") == 0);
+
+    auto range = headers.equal_range("Set-Cookie");
+    std::vector<std::string> values;
+    for (auto it = range.first; it != range.second; ++it) {
+        values.push_back(it->second);
+    }
+    CHECK(values == std::vector<std::string>{"a=1", "b=2", "c=3"});
+
+    const auto &const_headers = headers;
+    auto missing = const_headers.equal_range("missing");
+    CHECK(missing.first == missing.second);
+
+    CHECK(headers.erase("SET-cookie") == 3);
+    CHECK(headers.erase("set-cookie") == 0);
+    REQUIRE(headers.size() == 1);
+    CHECK(headers.find("host")->second == "example.com");
+
+    headers.emplace("Via", "proxy");
+    headers.erase(headers.find("host"));
+    REQUIRE(headers.size() == 1);
+    CHECK(headers.find("via") != headers.end());
+    CHECK(headers.find("host") == headers.end());
+}
+
+TEST_CASE("FlatHeaders backs Request and Response headers") {
+    httplib::Request req;
+    req.set_header("Accept-Encoding", "gzip");
+    req.headers.emplace("accept-encoding", "br");
+    CHECK(req.has_header("ACCEPT-ENCODING"));
+    CHECK(req.get_header_value_count("accept-encoding") == 2);
+    CHECK(req.get_header_value("Accept-Encoding", "", 1) == "br");
+
+    httplib::Response res;
+    res.set_header("Content-Length", "0");
+    for (auto &[name, value] : res.headers) {
+        value = name + ":" + value;
+    }
+    CHECK(res.get_header_value("content-length") == "Content-Length:0");
+}
@@ -0,0 +1,81 @@
+#include "doctest.hpp"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include <oryx/crt/httplib_task_queue.hpp>
+
+using namespace oryx::crt;
+
+TEST_CASE("PooledTaskQueue runs every task on the shared pool") {
+    BS::light_thread_pool pool(4);
+    PooledTaskQueue queue(pool);
+
+    std::atomic<int> count{0};
+    for (int i = 0; i < 1000; ++i) {
+        CHECK(queue.enqueue([&] { count++; }));
+    }
+    queue.shutdown();
+
+    CHECK_EQ(count.load(), 1000);
+    CHECK_EQ(queue.Pending(), 0);
+    CHECK_FALSE(queue.enqueue([] {}));
+
+    // The pool outlives the queue
+    CHECK(pool.submit_task([] { return 42; }).get() == 42);
+}
+
+TEST_CASE("PooledTaskQueue rejects tasks beyond max_queued") {
+    BS::light_thread_pool pool(1);
+    PooledTaskQueue queue(pool, 2);
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    CHECK(queue.enqueue([released] { released.wait(); }));
+    CHECK(queue.enqueue([] {}));
+    CHECK_FALSE(queue.enqueue([] {}));
+
+    release.set_value();
+    queue.shutdown();
+    CHECK_EQ(queue.Pending(), 0);
+}
+
+TEST_CASE("PooledTaskQueue releases throwing tasks") {
+    BS::light_thread_pool pool(2);
+    PooledTaskQueue queue(pool);
+
+    std::atomic<int> count{0};
+    for (int i = 0; i < 100; ++i) {
+        CHECK(queue.enqueue([&, i] {
+            count++;
+            if (i % 2 == 0) {
+                throw std::runtime_error("boom");
+            }
+        }));
+    }
+    queue.shutdown();
+
+    CHECK_EQ(count.load(), 100);
+    CHECK_EQ(queue.Pending(), 0);
+}
+
+TEST_CASE("PooledTaskQueue queues connections with its priority") {
+    BS::priority_thread_pool pool(1);
+    PooledTaskQueue queue(pool, 0, BS::pr::high);
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    pool.detach_task([released] { released.wait(); });
+
+    std::mutex mtx;
+    std::vector<int> order;
+    pool.detach_task([&] { std::lock_guard lock{mtx}; order.push_back(0); }, BS::pr::low);
+    queue.enqueue([&] { std::lock_guard lock{mtx}; order.push_back(1); });
+
+    release.set_value();
+    queue.shutdown();
+    pool.wait();
+    CHECK_EQ(order, std::vector<int>{1, 0});
+}
@@ -0,0 +1,338 @@
+#include "doctest.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <oryx/crt/httplib.hpp>
+
+namespace {
+
+// Server dispatch in isolation: the tree proposes a route and the matchers confirm it
+class Router {
+public:
+    Router(std::initializer_list<std::string> patterns) {
+        for (const auto &pattern : patterns) {
+            if (pattern.find("/:") != std::string::npos) {
+                matchers_.push_back(std::make_unique<httplib::detail::PathParamsMatcher>(pattern));
+            } else {
+                matchers_.push_back(std::make_unique<httplib::detail::RegexMatcher>(pattern));
+            }
+            tree_.add(pattern, matchers_.size() - 1);
+        }
+    }
+
+    auto route(const std::string &path) const -> size_t {
+        httplib::Request req;
+        req.path = path;
+        return tree_.find(path, [&](size_t i) { return matchers_[i]->match(req); });
+    }
+
+    // What the server did before the tree, the first matcher in registration order
+    auto linear(const std::string &path) const -> size_t {
+        httplib::Request req;
+        req.path = path;
+        for (size_t i = 0; i < matchers_.size(); ++i) {
+            if (matchers_[i]->match(req)) {
+                return i;
+            }
+        }
+        return httplib::detail::RouteTree::npos;
+    }
+
+private:
+    std::vector<std::unique_ptr<httplib::detail::MatcherBase>> matchers_;
+    httplib::detail::RouteTree tree_;
+};
+
+constexpr auto kNoRoute = httplib::detail::RouteTree::npos;
+
+struct TempDir {
+    TempDir()
+        : dir(std::filesystem::temp_directory_path() / "httplib_test_mount") {
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+    }
+
+    ~TempDir() { std::filesystem::remove_all(dir); }
+
+    void Write(const std::string &name, const std::string &content) const {
+        std::ofstream(dir / name, std::ios::binary) << content;
+    }
+
+    std::filesystem::path dir;
+};
+
+}  // namespace
+
+TEST_CASE("RingThreadPool rejects tasks when the ring is full") {
+    httplib::RingThreadPool pool(1, 2);
+
+    std::promise<void> started;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    REQUIRE(pool.enqueue([&started, released] {
+        started.set_value();
+        released.wait();
+    }));
+    started.get_future().wait();
+
+    std::atomic<int> count{0};
+    CHECK(pool.enqueue([&] { count++; }));
+    CHECK(pool.enqueue([&] { count++; }));
+    CHECK_FALSE(pool.enqueue([&] { count++; }));
+
+    release.set_value();
+    pool.shutdown();
+    CHECK_EQ(count.load(), 2);
+}
+
+TEST_CASE("RingThreadPool shutdown drains queued tasks") {
+    httplib::RingThreadPool pool(2, 64);
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<int> count{0};
+    for (int i = 0; i < 2; ++i) {
+        REQUIRE(pool.enqueue([&count, released] {
+            released.wait();
+            count++;
+        }));
+    }
+    for (int i = 0; i < 50; ++i) {
+        REQUIRE(pool.enqueue([&] { count++; }));
+    }
+
+    // Release the workers only after shutdown() started waiting for them
+    std::thread releaser([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        release.set_value();
+    });
+    pool.shutdown();
+    releaser.join();
+    CHECK_EQ(count.load(), 52);
+}
+
+TEST_CASE("RingThreadPool runs every task exactly once with concurrent producers") {
+    constexpr int kProducers = 4;
+    constexpr int kTasksPerProducer = 20000;
+
+    httplib::RingThreadPool pool(4, 64);
+    auto runs = std::make_unique<std::atomic<int>[]>(kProducers * kTasksPerProducer);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kTasksPerProducer; ++i) {
+                auto id = p * kTasksPerProducer + i;
+                // The ring is small, producers outrun the workers and retry
+                while (!pool.enqueue([&runs, id] { runs[id]++; })) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    pool.shutdown();
+
+    int wrong{};
+    for (int i = 0; i < kProducers * kTasksPerProducer; ++i) {
+        wrong += runs[i].load() != 1;
+    }
+    CHECK_EQ(wrong, 0);
+}
+
+TEST_CASE("RouteTree keeps registration order between regex and literal routes") {
+    Router router{"/files/.*", "/files/readme", "/static/index.html", "/static/.+", "/users/:id", "/users/\\d+"};
+
+    CHECK_EQ(router.route("/files/readme"), 0);
+    CHECK_EQ(router.route("/files/other"), 0);
+    CHECK_EQ(router.route("/static/index.html"), 2);
+    CHECK_EQ(router.route("/static/app.js"), 3);
+    CHECK_EQ(router.route("/users/42"), 4);
+    CHECK_EQ(router.route("/nothing"), kNoRoute);
+
+    for (const auto *path : {"/files/readme", "/files/", "/static/index.html", "/static/", "/users/42", "/users/x"}) {
+        CHECK_EQ(router.route(path), router.linear(path));
+    }
+}
+
+TEST_CASE("RouteTree path params match a whole segment") {
+    Router router{"/users/:id", "/users/:id/posts"};
+
+    CHECK_EQ(router.route("/users/5"), 0);
+    CHECK_EQ(router.route("/users/5/posts"), 1);
+    CHECK_EQ(router.route("/users/5/x"), kNoRoute);
+    CHECK_EQ(router.route("/users"), kNoRoute);
+    // PathParamsMatcher accepts an empty param and a trailing '/', the tree has to agree
+    CHECK_EQ(router.route("/users/"), 0);
+    CHECK_EQ(router.route("/users/5/"), 0);
+
+    for (const auto *path : {"/users/", "/users/5/", "/users/5/x", "/users/5/posts/", "/users//posts"}) {
+        CHECK_EQ(router.route(path), router.linear(path));
+    }
+}
+
+TEST_CASE("RouteTree splits edges of shared prefixes") {
+    Router router{"/api/users", "/api/uploads", "/api", "/apple", "/api/users/active"};
+
+    CHECK_EQ(router.route("/api/users"), 0);
+    CHECK_EQ(router.route("/api/uploads"), 1);
+    CHECK_EQ(router.route("/api"), 2);
+    CHECK_EQ(router.route("/apple"), 3);
+    CHECK_EQ(router.route("/api/users/active"), 4);
+    for (const auto *path : {"/ap", "/api/", "/api/u", "/api/usersx", "/apples", ""}) {
+        CHECK_EQ(router.route(path), kNoRoute);
+    }
+}
+
+TEST_CASE("RouteTree falls back to later regex routes when the candidate is rejected") {
+    httplib::detail::RouteTree tree;
+    tree.add("/a/b", 0);
+    tree.add("/a/.*", 1);
+    tree.add("/a/:x", 2);
+
+    CHECK_EQ(tree.find("/a/b", [](size_t) { return true; }), 0);
+    CHECK_EQ(tree.find("/a/b", [](size_t i) { return i != 0; }), 1);
+    CHECK_EQ(tree.find("/a/b", [](size_t i) { return i == 2; }), kNoRoute);
+    CHECK_EQ(tree.find("/a/c", [](size_t i) { return i == 2; }), 2);
+    CHECK_EQ(tree.find("/a/c", [](size_t) { return false; }), kNoRoute);
+}
+
+TEST_CASE("If-None-Match uses the weak ETag comparison") {
+    using httplib::detail::etag_matches;
+
+    CHECK(etag_matches("\"abc\"", "\"abc\""));
+    CHECK(etag_matches("W/\"abc\"", "\"abc\""));
+    CHECK(etag_matches("\"x\", \"abc\"", "\"abc\""));
+    CHECK(etag_matches("*", "\"abc\""));
+    CHECK_FALSE(etag_matches("\"abcd\"", "\"abc\""));
+    CHECK_FALSE(etag_matches("abc", "\"abc\""));
+    CHECK_FALSE(etag_matches("", "\"abc\""));
+}
+
+TEST_CASE("Server answers requests with a keep-alive timeout of 0") {
+    for (bool event_loop : {false, true}) {
+        CAPTURE(event_loop);
+
+        httplib::Server svr;
+        svr.set_keep_alive_timeout(0);
+        svr.set_event_loop(event_loop);
+        svr.Get("/", [](const httplib::Request &, httplib::Response &res) { res.set_content("ok", "text/plain"); });
+
+        auto port = svr.bind_to_any_port("127.0.0.1");
+        REQUIRE(port > 0);
+        std::thread listener([&] { svr.listen_after_bind(); });
+        svr.wait_until_ready();
+
+        int answered{};
+        for (int i = 0; i < 10; ++i) {
+            httplib::Client cli("127.0.0.1", port);
+            auto res = cli.Get("/");
+            answered += res && res->body == "ok";
+        }
+        svr.stop();
+        listener.join();
+        CHECK_EQ(answered, 10);
+    }
+}
+
+TEST_CASE("Accept-Encoding q-values") {
+    using httplib::detail::accepts_encoding;
+
+    CHECK(accepts_encoding("gzip", "gzip"));
+    CHECK(accepts_encoding("deflate, GZIP;q=0.5", "gzip"));
+    CHECK(accepts_encoding("*", "br"));
+    CHECK_FALSE(accepts_encoding("", "gzip"));
+    CHECK_FALSE(accepts_encoding("br", "gzip"));
+    CHECK_FALSE(accepts_encoding("gzip;q=0", "gzip"));
+    CHECK_FALSE(accepts_encoding("gzip;Q=0", "gzip"));
+    CHECK_FALSE(accepts_encoding("gzip; level=1; q=0.000", "gzip"));
+    CHECK_FALSE(accepts_encoding("*;q=0", "gzip"));
+
+    SUBCASE("an explicit coding takes precedence over *") {
+        CHECK_FALSE(accepts_encoding("gzip;q=0, *", "gzip"));
+        CHECK_FALSE(accepts_encoding("*, gzip;q=0", "gzip"));
+        CHECK(accepts_encoding("gzip, *;q=0", "gzip"));
+        CHECK(accepts_encoding("gzip;q=0, *", "br"));
+        CHECK_FALSE(accepts_encoding("br, *;q=0", "gzip"));
+    }
+}
+
+TEST_CASE("CompressionCache evicts the least recently used bodies") {
+    using httplib::detail::EncodingType;
+
+    // Every entry takes 2 bytes of body and 2 of compressed data
+    httplib::detail::CompressionCache cache(8);
+    std::string compressed;
+
+    CHECK_FALSE(cache.find(EncodingType::Gzip, "aa", compressed));
+    cache.insert(EncodingType::Gzip, "aa", "A1");
+    cache.insert(EncodingType::Gzip, "bb", "B1");
+    REQUIRE(cache.find(EncodingType::Gzip, "aa", compressed));
+    CHECK_EQ(compressed, "A1");
+    CHECK_FALSE(cache.find(EncodingType::Brotli, "aa", compressed));
+
+    // "aa" was used last, "bb" goes
+    cache.insert(EncodingType::Gzip, "cc", "C1");
+    CHECK_FALSE(cache.find(EncodingType::Gzip, "bb", compressed));
+    CHECK(cache.find(EncodingType::Gzip, "aa", compressed));
+    CHECK(cache.find(EncodingType::Gzip, "cc", compressed));
+
+    // Larger than the whole budget, never cached
+    cache.insert(EncodingType::Gzip, "dddd", "D1234");
+    CHECK_FALSE(cache.find(EncodingType::Gzip, "dddd", compressed));
+    CHECK(cache.find(EncodingType::Gzip, "aa", compressed));
+}
+
+TEST_CASE("Mount points serve precompressed siblings") {
+    TempDir tmp;
+    tmp.Write("app.js", "plain");
+    tmp.Write("app.js.gz", "gzipped");
+
+    httplib::Server svr;
+    svr.set_precompressed_files(true);
+    REQUIRE(svr.set_mount_point("/", tmp.dir.string()));
+
+    auto port = svr.bind_to_any_port("127.0.0.1");
+    REQUIRE(port > 0);
+    std::thread listener([&] { svr.listen_after_bind(); });
+    svr.wait_until_ready();
+
+    httplib::Client cli("127.0.0.1", port);
+    cli.set_decompress(false);
+
+    SUBCASE("the .gz sibling when gzip is accepted") {
+        auto res = cli.Get("/app.js", {{"Accept-Encoding", "gzip"}});
+        REQUIRE(res);
+        CHECK_EQ(res->status, 200);
+        CHECK_EQ(res->body, "gzipped");
+        CHECK_EQ(res->get_header_value("Content-Encoding"), "gzip");
+        CHECK_EQ(res->get_header_value("Vary"), "Accept-Encoding");
+        CHECK_EQ(res->get_header_value("Content-Type"), "text/javascript");
+    }
+
+    SUBCASE("the plain file without Accept-Encoding") {
+        // The client adds a default Accept-Encoding unless the body goes to a receiver
+        std::string body;
+        auto res = cli.Get("/app.js", [&](const char *data, size_t len) {
+            body.append(data, len);
+            return true;
+        });
+        REQUIRE(res);
+        CHECK_EQ(res->status, 200);
+        CHECK_EQ(body, "plain");
+        CHECK_FALSE(res->has_header("Content-Encoding"));
+        CHECK_EQ(res->get_header_value("Vary"), "Accept-Encoding");
+    }
+
+    svr.stop();
+    listener.join();
+}
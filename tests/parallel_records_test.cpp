@@ -0,0 +1,124 @@
+#include "doctest.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <oryx/crt/parallel_records.hpp>
+
+using namespace oryx::crt;
+
+namespace {
+
+auto MakeLines(size_t count) -> std::string {
+    std::string data;
+    for (size_t i = 0; i < count; ++i) {
+        data += "line " + std::to_string(i) + "\n";
+    }
+    return data;
+}
+
+auto Concat(std::vector<std::string> lhs, std::vector<std::string> rhs) -> std::vector<std::string> {
+    lhs.insert(lhs.end(), std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()));
+    return lhs;
+}
+
+}  // namespace
+
+TEST_CASE("ParallelReduceRecords counts every record exactly once") {
+    BS::light_thread_pool pool(4);
+    const auto data = MakeLines(10000);
+
+    for (size_t num_chunks : {1, 3, 4, 17, 100000}) {
+        for (bool ordered : {true, false}) {
+            auto count = ParallelReduceRecords(
+                pool, data, size_t{0}, [](size_t& acc, std::string_view) { acc++; },
+                [](size_t lhs, size_t rhs) { return lhs + rhs; },
+                {.delim = '\n', .num_chunks = num_chunks, .ordered = ordered});
+            CHECK_EQ(count, 10000);
+        }
+    }
+}
+
+TEST_CASE("ParallelReduceRecords preserves record order when ordered") {
+    BS::light_thread_pool pool(4);
+    const auto data = MakeLines(1000);
+
+    auto records = ParallelReduceRecords(
+        pool, data, std::vector<std::string>{},
+        [](std::vector<std::string>& acc, std::string_view record) { acc.emplace_back(record); }, Concat,
+        {.delim = '\n', .num_chunks = 8, .ordered = true});
+
+    REQUIRE_EQ(records.size(), 1000);
+    for (size_t i = 0; i < records.size(); ++i) {
+        CHECK_EQ(records[i], "line " + std::to_string(i));
+    }
+}
+
+TEST_CASE("ParallelReduceRecords propagates callback exceptions") {
+    BS::light_thread_pool pool(4);
+    const auto data = MakeLines(1000);
+
+    for (bool ordered : {true, false}) {
+        auto run = [&] {
+            return ParallelReduceRecords(
+                pool, data, size_t{0},
+                [](size_t& acc, std::string_view record) {
+                    if (record == "line 500") {
+                        throw std::runtime_error("bad record");
+                    }
+                    acc++;
+                },
+                [](size_t lhs, size_t rhs) { return lhs + rhs; },
+                {.delim = '\n', .num_chunks = 8, .ordered = ordered});
+        };
+        CHECK_THROWS_AS(run(), std::runtime_error);
+    }
+}
+
+TEST_CASE("ParallelReduceRecords waits for every block before rethrowing") {
+    BS::light_thread_pool pool(4);
+    const auto data = MakeLines(1000);
+
+    for (bool ordered : {true, false}) {
+        std::atomic<bool> slow_done{false};
+        auto run = [&] {
+            return ParallelReduceRecords(
+                pool, data, size_t{0},
+                [&](size_t& acc, std::string_view record) {
+                    if (record == "line 0") {
+                        throw std::runtime_error("bad record");
+                    }
+                    if (record == "line 999") {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                        slow_done = true;
+                    }
+                    acc++;
+                },
+                [](size_t lhs, size_t rhs) { return lhs + rhs; },
+                {.delim = '\n', .num_chunks = 4, .ordered = ordered});
+        };
+        CHECK_THROWS_AS(run(), std::runtime_error);
+        CHECK(slow_done.load());
+    }
+}
+
+TEST_CASE("ParallelReduceRecords record edge cases") {
+    BS::light_thread_pool pool(2);
+    auto collect = [&](std::string_view data, size_t num_chunks) {
+        return ParallelReduceRecords(
+            pool, data, std::vector<std::string>{},
+            [](std::vector<std::string>& acc, std::string_view record) { acc.emplace_back(record); }, Concat,
+            {.delim = ';', .num_chunks = num_chunks});
+    };
+
+    for (size_t num_chunks : {1, 2, 5}) {
+        CHECK(collect("", num_chunks).empty());
+        CHECK(collect("a;b;c", num_chunks) == std::vector<std::string>{"a", "b", "c"});
+        CHECK(collect("a;;b;", num_chunks) == std::vector<std::string>{"a", "", "b"});
+        CHECK(collect(";;", num_chunks) == std::vector<std::string>{"", ""});
+    }
+}
@@ -0,0 +1,119 @@
+#include "doctest.hpp"
+
+#include <string>
+#include <vector>
+#include <filesystem>
+
+#ifndef _WIN32
+    #include <thread>
+    #include <unistd.h>
+#endif
+
+#include <oryx/crt/record_reader.hpp>
+
+using namespace oryx::crt;
+
+namespace {
+
+struct TempFile {
+    explicit TempFile(std::string_view content)
+        : file(std::filesystem::temp_directory_path()) {
+        file.append("record_reader_tmp.txt");
+        auto file_ptr = OpenFile(file.string(), "wb");
+        fwrite(content.data(), 1, content.size(), file_ptr.get());
+    }
+
+    ~TempFile() { std::filesystem::remove_all(file); }
+
+    auto Open() { return OpenFile(file.string(), "rb"); }
+
+    std::filesystem::path file;
+};
+
+auto ReadAll(RecordReader& reader) {
+    std::vector<std::string> records;
+    while (auto record = reader.Next()) {
+        records.emplace_back(*record);
+    }
+    return records;
+}
+
+}  // namespace
+
+TEST_CASE("RecordReader maps regular files") {
+    TempFile tmp_file{"first\nsecond\n\nfourth"};
+    RecordReader reader{tmp_file.Open()};
+    CHECK(reader.IsMapped());
+    CHECK(ReadAll(reader) == std::vector<std::string>{"first", "second", "", "fourth"});
+}
+
+TEST_CASE("RecordReader trailing delimiter and custom delimiter") {
+    TempFile tmp_file{"a;b;"};
+    RecordReader reader{tmp_file.Open(), ';'};
+    CHECK(ReadAll(reader) == std::vector<std::string>{"a", "b"});
+}
+
+TEST_CASE("RecordReader empty and missing files") {
+    TempFile tmp_file{""};
+    RecordReader empty{tmp_file.Open()};
+    CHECK_FALSE(empty.Next());
+
+    RecordReader missing{OpenFile("/this/file/does/not/exist", "rb")};
+    CHECK_FALSE(missing.Next());
+}
+
+TEST_CASE("RecordReader starts at the stream position") {
+    TempFile tmp_file{"first\nsecond\nthird"};
+    auto file = tmp_file.Open();
+    char line[16];
+    // stdio buffers the whole file, the reader has to continue after the first line anyway
+    REQUIRE(fgets(line, sizeof(line), file.get()));
+    RecordReader reader{std::move(file)};
+    CHECK(reader.IsMapped());
+    CHECK(ReadAll(reader) == std::vector<std::string>{"second", "third"});
+}
+
+TEST_CASE("MappedFile exposes whole file") {
+    TempFile tmp_file{"Hello World"};
+    auto mapped = MappedFile::Open(tmp_file.file.string());
+    REQUIRE(mapped.IsValid());
+    CHECK(mapped.View() == "Hello World");
+
+    auto moved = std::move(mapped);
+    CHECK_FALSE(mapped.IsValid());
+    CHECK(moved.View() == "Hello World");
+}
+
+#ifndef _WIN32
+TEST_CASE("RecordReader buffers pipes with records larger than the buffer") {
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+
+    std::string long_record(100, 'x');
+    std::string content = "short\n" + long_record + "\n\nlast";
+    std::jthread writer([&]() {
+        for (char c : content) {
+            REQUIRE(write(fds[1], &c, 1) == 1);
+        }
+        close(fds[1]);
+    });
+
+    RecordReader reader{UniqueFilePtr{fdopen(fds[0], "rb")}, '\n', 8};
+    CHECK_FALSE(reader.IsMapped());
+    CHECK(ReadAll(reader) == std::vector<std::string>{"short", long_record, "", "last"});
+}
+
+TEST_CASE("RecordReader reports read errors") {
+    TempFile tmp_file{"first\n"};
+    // Neither mappable nor readable
+    RecordReader reader{OpenFile(tmp_file.file.string(), "ab")};
+    CHECK_FALSE(reader.IsMapped());
+    CHECK_FALSE(reader.Next());
+    REQUIRE(reader.ReadError());
+    CHECK(reader.ReadError()->code() == std::errc::bad_file_descriptor);
+
+    RecordReader readable{tmp_file.Open()};
+    CHECK(ReadAll(readable) == std::vector<std::string>{"first"});
+    CHECK_FALSE(readable.ReadError());
+}
+#endif
@@ -1,8 +1,12 @@
 #include "doctest.hpp"
 
+#include <algorithm>
+#include <array>
 #include <stop_token>
+#include <thread>
 
 #include <oryx/crt/retry.hpp>
+#include <oryx/crt/stopwatch.hpp>
 
 using namespace std::chrono_literals;
 using namespace oryx::crt;
@@ -86,4 +90,97 @@ TEST_CASE("Works with stop token as expected") {
     config.max_retries = 10;
     CHECK_FALSE(retry::ExponentialBackoff(config, never_succeeds, ssource.get_token()));
     CHECK_EQ(tries_so_far, 5);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Backoff without jitter doubles up to max") {
+    retry::Backoff backoff{{.start_backoff = 10ms, .max_backoff = 50ms, .max_retries = 10}};
+    CHECK_EQ(backoff.Next(), 10ms);
+    CHECK_EQ(backoff.Next(), 20ms);
+    CHECK_EQ(backoff.Next(), 40ms);
+    CHECK_EQ(backoff.Next(), 50ms);
+    CHECK_EQ(backoff.Next(), 50ms);
+}
+
+TEST_CASE("Jittered backoff stays within bounds") {
+    constexpr int kSamples = 1000;
+    const retry::ExponentialConfig config{.start_backoff = 100ms, .max_backoff = 100ms, .max_retries = 1};
+
+    SUBCASE("Full jitter") {
+        auto jittered = config;
+        jittered.jitter = retry::Jitter::kFull;
+        retry::Backoff backoff{jittered};
+        for (int i = 0; i < kSamples; ++i) {
+            auto wait = backoff.Next();
+            CHECK((wait >= 0ms && wait <= 100ms));
+        }
+    }
+
+    SUBCASE("Equal jitter") {
+        auto jittered = config;
+        jittered.jitter = retry::Jitter::kEqual;
+        retry::Backoff backoff{jittered};
+        for (int i = 0; i < kSamples; ++i) {
+            auto wait = backoff.Next();
+            CHECK((wait >= 50ms && wait <= 100ms));
+        }
+    }
+
+    SUBCASE("Decorrelated jitter") {
+        auto jittered = config;
+        jittered.start_backoff = 10ms;
+        jittered.jitter = retry::Jitter::kDecorrelated;
+        retry::Backoff backoff{jittered};
+        for (int i = 0; i < kSamples; ++i) {
+            auto wait = backoff.Next();
+            CHECK((wait >= 10ms && wait <= 100ms));
+        }
+    }
+}
+
+TEST_CASE("Jitter spreads out clients failing at the same time") {
+    retry::ExponentialConfig config{.start_backoff = 1000ms, .max_backoff = 1000ms, .max_retries = 1};
+    config.jitter = retry::Jitter::kFull;
+
+    std::array<int, 10> buckets{};
+    for (int client = 0; client < 1000; ++client) {
+        retry::Backoff backoff{config};
+        buckets[std::min<size_t>(backoff.Next().count() / 100, buckets.size() - 1)]++;
+    }
+    CHECK(std::ranges::all_of(buckets, [](int hits) { return hits > 0 && hits < 250; }));
+}
+
+TEST_CASE("Retry budget caps retries") {
+    retry::RetryBudget budget{0.1, 2};
+    auto config = kDefaultConfig;
+    config.max_retries = 100;
+    config.budget = &budget;
+
+    int tries_so_far = 0;
+    CHECK_FALSE(retry::ExponentialBackoff(config, [&]() {
+        tries_so_far++;
+        return false;
+    }));
+    // First attempt plus the two tokens of the initial burst
+    CHECK_EQ(tries_so_far, 3);
+    CHECK(budget.Tokens() < 1.0);
+
+    for (int i = 0; i < 10; ++i) {
+        budget.Deposit();
+    }
+    CHECK(budget.TryWithdraw());
+    CHECK_FALSE(budget.TryWithdraw());
+}
+
+TEST_CASE("Stop token interrupts backoff wait") {
+    std::stop_source ssource{};
+    const retry::ExponentialConfig config{.start_backoff = 10s, .max_backoff = 10s, .max_retries = 10};
+
+    std::jthread stopper([&ssource]() {
+        std::this_thread::sleep_for(50ms);
+        ssource.request_stop();
+    });
+
+    Stopwatch sw{};
+    CHECK_FALSE(retry::ExponentialBackoff(config, []() { return false; }, ssource.get_token()));
+    CHECK(sw.ElapsedMs() < 1s);
+}
@@ -0,0 +1,109 @@
+#include "doctest.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <oryx/crt/small_vector.hpp>
+
+using namespace oryx::crt;
+
+TEST_CASE("SmallVector stays inline up to its capacity") {
+    SmallVector<std::string, 2> vec;
+    CHECK(vec.empty());
+    CHECK(vec.IsInline());
+
+    vec.push_back("first");
+    vec.emplace_back("second");
+    CHECK(vec.IsInline());
+    CHECK_EQ(vec.size(), 2);
+
+    vec.emplace_back("third");
+    CHECK_FALSE(vec.IsInline());
+    CHECK_EQ(vec.size(), 3);
+    CHECK_EQ(vec[0], "first");
+    CHECK_EQ(vec[1], "second");
+    CHECK_EQ(vec.back(), "third");
+}
+
+TEST_CASE("SmallVector emplace_back of own element while growing") {
+    SmallVector<std::string, 1> vec{std::string(32, 'a')};
+    vec.push_back(vec.front());
+    CHECK_EQ(vec.size(), 2);
+    CHECK_EQ(vec[1], std::string(32, 'a'));
+}
+
+namespace {
+
+struct Throwing {
+    static inline int live = 0;
+
+    explicit Throwing(bool fail) {
+        if (fail) {
+            throw std::runtime_error("construction failed");
+        }
+        ++live;
+    }
+
+    Throwing(Throwing&&) noexcept { ++live; }
+
+    ~Throwing() { --live; }
+};
+
+}  // namespace
+
+TEST_CASE("SmallVector keeps its elements if construction throws while growing") {
+    {
+        SmallVector<Throwing, 2> vec;
+        vec.emplace_back(false);
+        vec.emplace_back(false);
+        auto* data = vec.data();
+
+        CHECK_THROWS_AS(vec.emplace_back(true), std::runtime_error);
+        CHECK_EQ(vec.size(), 2);
+        CHECK_EQ(vec.data(), data);
+        CHECK_EQ(Throwing::live, 2);
+
+        vec.emplace_back(false);
+        CHECK_EQ(vec.size(), 3);
+    }
+    CHECK_EQ(Throwing::live, 0);
+}
+
+TEST_CASE("SmallVector copy and move") {
+    SUBCASE("Inline") {
+        SmallVector<std::string, 4> original{"a", "b"};
+        auto copy = original;
+        CHECK_EQ(copy.size(), 2);
+        CHECK_EQ(copy[1], "b");
+
+        auto moved = std::move(original);
+        CHECK(moved.IsInline());
+        CHECK_EQ(moved.size(), 2);
+        CHECK_EQ(moved[0], "a");
+    }
+
+    SUBCASE("Heap") {
+        SmallVector<std::unique_ptr<int>, 1> original;
+        original.push_back(std::make_unique<int>(1));
+        original.push_back(std::make_unique<int>(2));
+        auto* data = original.data();
+
+        SmallVector<std::unique_ptr<int>, 1> moved;
+        moved.push_back(std::make_unique<int>(3));
+        moved = std::move(original);
+        CHECK_EQ(moved.data(), data);
+        CHECK_EQ(*moved[1], 2);
+        CHECK(original.IsInline());
+        CHECK(original.empty());
+    }
+}
+
+TEST_CASE("SmallVector clear and pop_back") {
+    SmallVector<int, 2> vec{1, 2, 3};
+    vec.pop_back();
+    CHECK_EQ(vec.size(), 2);
+    vec.clear();
+    CHECK(vec.empty());
+    CHECK(vec.capacity() >= 3);
+}
@@ -1,11 +1,32 @@
 #include "doctest.hpp"
 
+#include <array>
 #include <cstdio>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
 
 #include <oryx/crt/string_split.hpp>
 
 namespace oryx::crt {
 
+namespace {
+
+auto ReferenceSplitAny(std::string_view input, std::string_view delims) -> std::vector<std::string_view> {
+    std::vector<std::string_view> result;
+    size_t pos{};
+    size_t delim_pos;
+    while ((delim_pos = input.find_first_of(delims, pos)) != std::string_view::npos) {
+        result.emplace_back(input.substr(pos, delim_pos - pos));
+        pos = delim_pos + 1;
+    }
+    result.emplace_back(input.substr(pos));
+    return result;
+}
+
+}  // namespace
+
 TEST_CASE("split string -") {
     const auto split = StringSplit("this-will-be-split", '-');
     REQUIRE_FALSE(split.empty());
@@ -33,4 +54,116 @@ TEST_CASE("nothing will be split") {
     REQUIRE(split[0] == "this will not be split");
 }
 
+TEST_CASE("split view yields the same fields as split") {
+    for (std::string_view input : {"this-will-be-split", "", "-", "--leading", "trailing--", "no delimiter"}) {
+        std::vector<std::string_view> lazy;
+        for (auto field : StringSplitView(input, '-')) {
+            lazy.push_back(field);
+        }
+        CHECK(lazy == StringSplit(input, '-'));
+    }
+}
+
+TEST_CASE("split view works with range adaptors") {
+    static_assert(std::ranges::forward_range<StringSplitView>);
+    static_assert(std::ranges::view<StringSplitView>);
+
+    auto first = StringSplitView("id,name,value", ',') | std::views::take(1);
+    CHECK(*first.begin() == "id");
+
+    auto non_empty = StringSplitView("a,,b,", ',') | std::views::filter([](auto field) { return !field.empty(); });
+    CHECK(std::ranges::distance(non_empty) == 2);
+}
+
+TEST_CASE("split view is usable at compile time") {
+    constexpr auto kNumFields = std::ranges::distance(StringSplitView("a:b:c", ':'));
+    static_assert(kNumFields == 3);
+}
+
+TEST_CASE("split into caller provided buffer") {
+    std::array<std::string_view, 4> fields{};
+
+    SUBCASE("fits into buffer") {
+        REQUIRE(StringSplitInto("this-will-be-split", '-', fields) == 4);
+        CHECK(fields[0] == "this");
+        CHECK(fields[3] == "split");
+    }
+
+    SUBCASE("remainder goes into last slot") {
+        REQUIRE(StringSplitInto("a-b-c-d-e-f", '-', fields) == 4);
+        CHECK(fields[2] == "c");
+        CHECK(fields[3] == "d-e-f");
+    }
+
+    SUBCASE("fewer fields than buffer") {
+        REQUIRE(StringSplitInto("a-b", '-', fields) == 2);
+        CHECK(fields[1] == "b");
+    }
+
+    SUBCASE("empty buffer") { CHECK(StringSplitInto("a-b", '-', std::span<std::string_view>{}) == 0); }
+}
+
+TEST_CASE("split on any delimiter") {
+    const auto split = StringSplit("key=value;other=1", "=;");
+    REQUIRE(split.size() == 4);
+    CHECK(split[0] == "key");
+    CHECK(split[1] == "value");
+    CHECK(split[2] == "other");
+    CHECK(split[3] == "1");
+
+    std::array<std::string_view, 2> fields{};
+    REQUIRE(StringSplitInto("a b\tc", " \t", fields) == 2);
+    CHECK(fields[0] == "a");
+    CHECK(fields[1] == "b\tc");
+
+    static_assert(std::ranges::distance(StringSplitAnyView("a,b;c", ",;")) == 3);
+}
+
+TEST_CASE("split on any delimiter matches reference on random input") {
+    std::mt19937 rng{42};
+    constexpr std::string_view kAlphabet = "abc,;|\t x\"\n=";
+    std::uniform_int_distribution<size_t> pick(0, kAlphabet.size() - 1);
+
+    for (std::string_view delims : {",", ",;", ",;|\t x=", ",;|\t x=\"\n", "z"}) {
+        for (size_t length : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 200}) {
+            std::string input(length, ' ');
+            for (auto& c : input) {
+                c = kAlphabet[pick(rng)];
+            }
+            CHECK(StringSplit(input, delims) == ReferenceSplitAny(input, delims));
+        }
+    }
+}
+
+TEST_CASE("split on any delimiter with many delimiters per block") {
+    for (size_t length : {1, 16, 33, 100}) {
+        const std::string only_delims(length, ';');
+        CHECK(StringSplit(only_delims, ",;") == ReferenceSplitAny(only_delims, ",;"));
+
+        std::string alternating;
+        for (size_t i = 0; i < length; ++i) {
+            alternating += i % 2 ? ',' : 'a';
+        }
+        const auto expected = ReferenceSplitAny(alternating, ",;");
+        CHECK(StringSplit(alternating, ",;") == expected);
+
+        std::vector<std::string_view> fields(expected.size());
+        REQUIRE(StringSplitInto(alternating, ",;", fields) == expected.size());
+        CHECK(fields == expected);
+    }
+
+    SUBCASE("copied iterators advance independently") {
+        const std::string input = "a,b;c,d;e,f;g,h;i,j;k,l;m,n;o,p;q,r";
+        StringSplitAnyView view(input, ",;");
+        auto it = view.begin();
+        ++it;
+        auto copy = it;
+        ++it;
+        ++it;
+        CHECK(*copy == "b");
+        CHECK(*++copy == "c");
+        CHECK(*it == "d");
+    }
+}
+
 }  // namespace oryx::crt
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "doctest.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <string_view>
+#include <unordered_set>
+
+#include <oryx/crt/uuid.hpp>
+
+using namespace oryx::crt;
+
+namespace {
+
+auto IsValidUuid4(std::string_view uuid) -> bool {
+    if (uuid.size() != 36) {
+        return false;
+    }
+    for (size_t i = 0; i < uuid.size(); ++i) {
+        const char c = uuid[i];
+        if (i == 8 || i == 13 || i == 18 || i == 23) {
+            if (c != '-') {
+                return false;
+            }
+        } else if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return false;
+        }
+    }
+    const char variant = uuid[19];
+    return uuid[14] == '4' && (variant == '8' || variant == '9' || variant == 'a' || variant == 'b');
+}
+
+}  // namespace
+
+TEST_CASE("Generate returns a version 4 uuid") {
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(IsValidUuid4(uuid4::Generate()));
+    }
+}
+
+TEST_CASE("GenerateFast returns unique version 4 uuids") {
+    std::unordered_set<std::string> seen;
+    for (int i = 0; i < 10'000; ++i) {
+        auto uuid = uuid4::GenerateFast();
+        std::string_view view{uuid.data(), uuid.size()};
+        REQUIRE(IsValidUuid4(view));
+        REQUIRE(seen.emplace(view).second);
+    }
+}
+
+TEST_CASE("Uuid parses and formats the canonical form") {
+    static constexpr std::string_view kText = "123e4567-e89b-42d3-a456-426614174000";
+    static constexpr auto kUuid = Uuid::Parse(kText);
+    static_assert(kUuid.has_value() && kUuid->Version() == 4);
+    static_assert(kUuid->Bytes()[0] == 0x12 && kUuid->Bytes()[15] == 0x00);
+
+    constexpr auto kChars = kUuid->ToChars();
+    CHECK(std::string_view(kChars.data(), kChars.size()) == kText);
+    CHECK(kUuid->ToString() == kText);
+    CHECK(Uuid::Parse("123E4567-E89B-42D3-A456-426614174000") == kUuid);
+    CHECK(Uuid().IsNil());
+    CHECK(Uuid::Parse("00000000-0000-0000-0000-000000000000")->IsNil());
+}
+
+TEST_CASE("Uuid rejects malformed input") {
+    CHECK_FALSE(Uuid::Parse(""));
+    CHECK_FALSE(Uuid::Parse("123e4567e89b42d3a456426614174000"));
+    CHECK_FALSE(Uuid::Parse("123e4567-e89b-42d3-a456-42661417400"));
+    CHECK_FALSE(Uuid::Parse("123e4567-e89b-42d3-a456-4266141740000"));
+    CHECK_FALSE(Uuid::Parse("123e4567-e89b-42d3-a456-42661417400g"));
+    CHECK_FALSE(Uuid::Parse("123e4567-e89b-42d3-a456-4266-4174000"));
+    CHECK_FALSE(Uuid::Parse("123e4567-e89b-42d3-a456-42661417400:"));
+    CHECK_FALSE(Uuid::Parse("@23e4567-e89b-42d3-a456-426614174000"));
+    CHECK_FALSE(Uuid::Parse("\xff" "23e4567-e89b-42d3-a456-426614174000"));
+}
+
+TEST_CASE("Uuid round trips generated values") {
+    for (int i = 0; i < 1000; ++i) {
+        auto uuid = uuid4::GenerateBinary();
+        REQUIRE(uuid.Version() == 4);
+        REQUIRE(Uuid::Parse(uuid.ToString()) == uuid);
+    }
+}
+
+TEST_CASE("Uuid works as hash map key") {
+    std::unordered_set<Uuid> seen;
+    for (int i = 0; i < 10'000; ++i) {
+        REQUIRE(seen.insert(uuid4::GenerateBinary()).second);
+    }
+}
+
+TEST_CASE("uuid7 values are time ordered") {
+    std::vector<Uuid> uuids;
+    for (int i = 0; i < 10'000; ++i) {
+        uuids.push_back(uuid7::Generate());
+    }
+
+    CHECK(std::ranges::is_sorted(uuids, std::less<>{}));
+    CHECK(std::ranges::adjacent_find(uuids) == uuids.end());
+    for (const auto& uuid : uuids) {
+        REQUIRE(uuid.Version() == 7);
+        REQUIRE((uuid.Bytes()[8] & 0xC0) == 0x80);
+    }
+}
+
+TEST_CASE("GenerateMany fills the whole span with unique uuids") {
+    std::vector<Uuid> uuids(10'000);
+    uuid4::GenerateMany(uuids);
+
+    std::unordered_set<Uuid> seen;
+    for (const auto& uuid : uuids) {
+        REQUIRE(uuid.Version() == 4);
+        REQUIRE((uuid.Bytes()[8] & 0xC0) == 0x80);
+        REQUIRE(seen.insert(uuid).second);
+    }
+}
+
+TEST_CASE("GenerateInto writes canonical uuids back to back") {
+    constexpr size_t kCount = 1000;
+    std::string buffer(kCount * Uuid::kStringSize + 1, '#');
+    uuid4::GenerateInto(buffer.data(), kCount);
+
+    CHECK(buffer.back() == '#');
+    std::unordered_set<std::string_view> seen;
+    for (size_t i = 0; i < kCount; ++i) {
+        auto uuid = std::string_view(buffer).substr(i * Uuid::kStringSize, Uuid::kStringSize);
+        REQUIRE(IsValidUuid4(uuid));
+        REQUIRE(seen.insert(uuid).second);
+    }
+}